@@ -0,0 +1,127 @@
+#include "batchanalyzer.h"
+#include "connectfour.h"
+#include "connectfoursolver.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    // One line of the window; `index % window` picks the slot
+    struct Slot {
+        string input;
+        string output;
+        bool done = false;
+    };
+
+    // `moves` is "-" for the empty board, as the output writes it
+    string analyzeLine(ConnectFour& engine, const string& moves, int timeBudgetMs, uint64_t& nodes, bool& failed) {
+        ConnectFourBoard board;
+        int side;
+        string error;
+        failed = !ConnectFourSolver::parseMoves(moves == "-" ? "" : moves, board, side, error);
+        if (!failed && (board.hasWon(1 - side) || board.isFull())) {
+            failed = true;
+            error = "game is over";
+        }
+        if (failed) return moves + " error " + error + "\n";
+
+        ConnectFour::Analysis a = engine.analyze(board, side, timeBudgetMs);
+        nodes += a.nodes;
+        return moves + " " + to_string(a.col + 1) + " " + to_string(a.score) + " " +
+               to_string(a.depth) + " " + to_string(a.nodes) + " " +
+               to_string(static_cast<long long>(a.seconds * 1e6)) + "\n";
+    }
+}
+
+BatchAnalyzer::Stats BatchAnalyzer::run(istream& in, ostream& out) {
+    int workerCount = options.threads > 0 ? options.threads : max(1, static_cast<int>(thread::hardware_concurrency()));
+    const size_t window = options.window > 0 ? options.window : 64 * static_cast<size_t>(workerCount);
+    auto start = chrono::steady_clock::now();
+
+    vector<Slot> slots(window);
+    mutex m;
+    condition_variable workReady; // A line was read, or the input ended
+    condition_variable lineDone;  // A worker finished a line
+    uint64_t readCount = 0, nextTask = 0, writeCount = 0;
+    bool endOfInput = false;
+    Stats stats;
+
+    auto work = [&] {
+        // Engines are built on the worker so their tables are touched by it
+        ConnectFour engine(options.timeBudgetMs, options.transpositionTableMB, 1);
+        engine.setMaxDepth(options.maxDepth);
+        engine.setPondering(false);
+        uint64_t nodes = 0, errors = 0;
+
+        unique_lock<mutex> lock(m);
+        for (;;) {
+            workReady.wait(lock, [&] { return nextTask < readCount || endOfInput; });
+            if (nextTask == readCount) break; // Input ended and everything is taken
+            Slot& slot = slots[nextTask++ % window];
+            string input = move(slot.input);
+            lock.unlock();
+
+            bool failed;
+            string output = analyzeLine(engine, input, options.timeBudgetMs, nodes, failed);
+            if (failed) ++errors;
+
+            lock.lock();
+            slot.output = move(output);
+            slot.done = true;
+            lineDone.notify_one();
+        }
+        stats.nodes += nodes;
+        stats.errors += errors;
+    };
+
+    vector<thread> workers;
+    for (int i = 0; i < workerCount; ++i) workers.emplace_back(work);
+
+    // Reader and writer: keep the window full, write finished lines in order
+    string line, pending;
+    unique_lock<mutex> lock(m);
+    for (;;) {
+        while (writeCount < readCount && slots[writeCount % window].done) {
+            Slot& slot = slots[writeCount++ % window];
+            pending += slot.output;
+            slot.output.clear();
+            slot.done = false;
+        }
+        if (!pending.empty()) {
+            lock.unlock();
+            out << pending;
+            pending.clear();
+            lock.lock();
+            continue;
+        }
+        if (endOfInput && writeCount == readCount) break;
+        if (!endOfInput && readCount - writeCount < window) {
+            lock.unlock();
+            bool more = static_cast<bool>(getline(in, line));
+            if (more && !line.empty() && line.back() == '\r') line.pop_back();
+            lock.lock();
+            if (!more) {
+                endOfInput = true;
+                workReady.notify_all();
+            } else if (!line.empty()) {
+                slots[readCount++ % window].input = move(line);
+                workReady.notify_one();
+            }
+            continue;
+        }
+        lineDone.wait(lock);
+    }
+    lock.unlock();
+    for (thread& t : workers) t.join();
+    out.flush();
+
+    stats.positions = readCount;
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return stats;
+}
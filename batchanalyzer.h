@@ -0,0 +1,52 @@
+#ifndef BATCHANALYZER_H
+#define BATCHANALYZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Offline Connect Four analysis of a stream of positions.
+//
+// Every input line is a move sequence in 1-based column digits ("4453"),
+// or "-" for the empty board; every output line is "moves best-column
+// score depth nodes microseconds", or "moves error <reason>" for a line
+// that is not a legal game. Output lines come in input order (blank input
+// lines are skipped).
+//
+// The calling thread reads and writes; worker threads, each with its own
+// single-threaded engine, analyze positions. At most `window` positions are
+// between being read and being written, so memory use does not depend on
+// the input size: when the oldest unfinished position holds the window up,
+// reading pauses until it is done.
+//
+// Engines keep their transposition tables from one position to the next,
+// which pays off on consecutive positions of the same game. The price is
+// that a result can depend on what its worker analyzed before, so runs with
+// different thread counts may pick different moves of near-equal score.
+class BatchAnalyzer {
+public:
+    struct Options {
+        int timeBudgetMs = 20;          // Per position
+        int maxDepth = 0;               // Alpha-beta depth limit, 0 = time only
+        int threads = 0;                // Workers, 0 = one per core
+        size_t transpositionTableMB = 16; // Per worker
+        size_t window = 0;              // Positions in flight, 0 = 64 per worker
+    };
+
+    struct Stats {
+        uint64_t positions = 0; // Lines analyzed, errors included
+        uint64_t errors = 0;
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+    };
+
+    explicit BatchAnalyzer(const Options& options) : options(options) {}
+
+    Stats run(std::istream& in, std::ostream& out);
+
+private:
+    Options options;
+};
+
+#endif // BATCHANALYZER_H
@@ -0,0 +1,729 @@
+#include "commandline.h"
+#include "batchanalyzer.h"
+#include "connectfourboard.h"
+#include "connectfoursolver.h"
+#include "connectfour.h"
+#include "grundy.h"
+#include "mazebitmap.h"
+#include "mazesolver.h"
+#include "nimbatchsolver.h"
+#include "openingbook.h"
+#include "tictactoe.h"
+#include "tournament.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <iomanip>
+#include <chrono>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+
+void printUsage() {
+    cout << "Usage: gamehub [command] [arguments]\n"
+         << "Without a command the interactive menu starts.\n\n"
+         << "Commands:\n"
+         << "  solve [moves...]                  Solve Connect Four positions exactly. Moves are\n"
+         << "                                    1-based column digits (e.g. 4453); reads one\n"
+         << "                                    position per line from stdin if none are given.\n"
+         << "  solve-bench [count] [plies] [seed]\n"
+         << "                                    Solve `count` reproducible positions with `plies`\n"
+         << "                                    stones played; report mean time and nodes.\n"
+         << "  book-gen <file> [plies] [ms] [threads]\n"
+         << "                                    Build a ConnectFour opening book covering the first\n"
+         << "                                    `plies` plies (default 8), searching each book\n"
+         << "                                    position for `ms` milliseconds (default 200).\n"
+         << "  analyze <file> [ms] [depth] [threads]\n"
+         << "                                    Analyze one Connect Four position per line of\n"
+         << "                                    `file` (- for stdin; a line '-' is the empty\n"
+         << "                                    board) in parallel; prints the best column, score,\n"
+         << "                                    depth, nodes and microseconds per line, in input\n"
+         << "                                    order.\n"
+         << "  perft [game depth [moves]]        Count the leaves of the move tree to each depth up\n"
+         << "                                    to `depth`. Games: connectfour, connectfour8x7,\n"
+         << "                                    connectfour9x7, connectfive, connectfour5x4,\n"
+         << "                                    connectfour5x5, tictactoe (moves are cells 1-9).\n"
+         << "                                    Without arguments the reference suite\n"
+         << "                                    runs and is checked against known counts.\n"
+         << "  tablebase-gen <game> [threads] [min-stones] [file]\n"
+         << "                                    Build the endgame tablebase of connectfour5x4 or\n"
+         << "                                    connectfour5x5 down to positions with `min-stones`\n"
+         << "                                    stones (default 0, the whole game). Rerun to resume\n"
+         << "                                    an interrupted build.\n"
+         << "  bench                             Fixed-depth search of fixed positions with\n"
+         << "                                    ConnectFour alpha-beta and TicTacToe minimax;\n"
+         << "                                    prints nodes, time and speed per position.\n"
+         << "  grundy <moves> [heaps...]         Grundy table of the subtraction game taking any\n"
+         << "                                    amount in `moves` (comma-separated, e.g. 1,3,4):\n"
+         << "                                    its preperiod and period, and the Grundy value\n"
+         << "                                    of each heap size given.\n"
+         << "  nim-solve <file> [threads] [normal|misere]\n"
+         << "                                    Solve one Nim position per line of `file` (- for\n"
+         << "                                    stdin), pile sizes separated by spaces or commas;\n"
+         << "                                    prints a winning move (pile count) or 'losing'\n"
+         << "                                    per line, in input order.\n"
+         << "  maze-solve <file> [algorithm] [path]\n"
+         << "                                    Solve a maze file ('#' walls, S start, E end, or\n"
+         << "                                    binary from maze-convert) without animation with\n"
+         << "                                    astar (default), jps, jps+, bidir (from both ends),\n"
+         << "                                    bidir-threads (a thread per end) or all of them;\n"
+         << "                                    prints the shortest path length, cells expanded,\n"
+         << "                                    heap pushes and pops and time, and with `path`\n"
+         << "                                    the path's cells as row,col.\n"
+         << "  maze-convert <text> <binary>      Convert a text maze to the binary format (one bit\n"
+         << "                                    per cell), which maze-solve maps without parsing.\n"
+         << "  tournament <game> <engineA> <engineB> [games] [threads] [opening] [seed]\n"
+         << "                                    Play engines against each other headlessly and\n"
+         << "                                    report W/D/L, Elo difference and throughput;\n"
+         << "                                    run without arguments for the engine options.\n"
+         << "  help                              Show this message.\n";
+}
+
+// --- solve ---
+// One line per position: moves score outcome distance best-column nodes microseconds,
+// distance being the plies until the game ends (the remaining cells for a draw)
+bool solveOne(ConnectFourSolver& solver, const string& moves) {
+    ConnectFourBoard board;
+    int sideToMove;
+    string error;
+    if (!ConnectFourSolver::parseMoves(moves, board, sideToMove, error)) {
+        cerr << "Error: " << moves << ": " << error << "\n";
+        return false;
+    }
+    ConnectFourSolver::Result r = solver.solve(board, sideToMove);
+    cout << (moves.empty() ? "-" : moves) << " " << r.score << " " << ConnectFourSolver::outcome(r.score)
+         << " " << r.distance << " " << (r.bestMove + 1) << " " << r.nodes
+         << " " << static_cast<long long>(r.seconds * 1e6) << "\n";
+    return true;
+}
+
+int cmdSolve(const vector<string>& args) {
+    ConnectFourSolver solver(64);
+    bool ok = true;
+    if (!args.empty()) {
+        for (const string& moves : args) ok = solveOne(solver, moves) && ok;
+    } else {
+        string line;
+        while (getline(cin, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+            ok = solveOne(solver, line) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}
+// --- End solve ---
+
+// --- solve-bench ---
+// Positions come from seeded random play in which nobody ever wins or leaves
+// the opponent an immediate win, so the solver gets a real search every time.
+vector<string> benchmarkPositions(int count, int plies, unsigned seed) {
+    mt19937 rng(seed);
+    vector<string> positions;
+    while (static_cast<int>(positions.size()) < count) {
+        ConnectFourBoard board;
+        int side = ConnectFourBoard::HUMAN_SIDE;
+        string moves;
+        bool ok = true;
+        while (ok && board.moveCount() < plies) {
+            int candidates[ConnectFourBoard::COLS];
+            int n = 0;
+            for (int c = 0; c < ConnectFourBoard::COLS; ++c) {
+                if (!board.canPlay(c) || board.isWinningMove(c, side)) continue;
+                board.play(c, side);
+                bool givesWin = false;
+                for (int d = 0; d < ConnectFourBoard::COLS; ++d) {
+                    if (board.canPlay(d) && board.isWinningMove(d, 1 - side)) givesWin = true;
+                }
+                board.undo(c);
+                if (!givesWin) candidates[n++] = c;
+            }
+            if (n == 0) { ok = false; break; }
+            int col = candidates[rng() % n];
+            board.play(col, side);
+            moves += static_cast<char>('1' + col);
+            side = 1 - side;
+        }
+        if (ok) positions.push_back(moves);
+    }
+    return positions;
+}
+
+int cmdSolveBench(const vector<string>& args) {
+    int count = args.size() > 0 ? atoi(args[0].c_str()) : 50;
+    int plies = args.size() > 1 ? atoi(args[1].c_str()) : 24;
+    unsigned seed = args.size() > 2 ? static_cast<unsigned>(atoi(args[2].c_str())) : 1;
+    if (count <= 0 || plies < 0 || plies >= ConnectFourBoard::ROWS * ConnectFourBoard::COLS) {
+        cerr << "Error: invalid solve-bench arguments.\n";
+        return 1;
+    }
+
+    ConnectFourSolver solver(64);
+    vector<string> positions = benchmarkPositions(count, plies, seed);
+    double totalSeconds = 0.0;
+    uint64_t totalNodes = 0;
+    for (const string& moves : positions) {
+        ConnectFourBoard board;
+        int side;
+        string error;
+        ConnectFourSolver::parseMoves(moves, board, side, error);
+        solver.reset(); // Every position starts with an empty table
+        ConnectFourSolver::Result r = solver.solve(board, side);
+        totalSeconds += r.seconds;
+        totalNodes += r.nodes;
+    }
+    cout << fixed << setprecision(6)
+         << "positions " << positions.size() << " plies " << plies << " seed " << seed
+         << " mean_seconds " << totalSeconds / positions.size()
+         << " mean_nodes " << totalNodes / positions.size()
+         << " knps " << setprecision(1) << (totalSeconds > 0 ? totalNodes / totalSeconds / 1e3 : 0.0) << "\n";
+    return 0;
+}
+// --- End solve-bench ---
+
+// --- book-gen ---
+// The book follows its own moves: wherever the book side is to move only the
+// searched best move is expanded, while every reply of the other side is.
+// This is done once with the book playing first and once playing second.
+struct BookGenerator {
+    ConnectFour& engine;
+    int maxPly;
+    int timeBudgetMs;
+    vector<OpeningBook::Record> records;
+    unordered_set<uint64_t> visited; // Canonical keys expanded in the current pass
+
+    void expand(ConnectFourBoard& board, int sideToMove, int bookSide) {
+        if (board.moveCount() >= maxPly || board.hasWon(1 - sideToMove) || board.isFull()) return;
+        bool mirrored;
+        uint64_t key = OpeningBook::canonicalKey(board.sideMask(sideToMove), board.occupiedMask(), mirrored);
+        if (!visited.insert(key).second) return;
+
+        if (sideToMove == bookSide) {
+            ConnectFour::Analysis a = engine.analyze(board, sideToMove, timeBudgetMs);
+            if (a.col < 0) return;
+            OpeningBook::Record r;
+            r.key = key;
+            r.col = mirrored ? ConnectFourBoard::COLS - 1 - a.col : a.col;
+            r.score = a.score;
+            records.push_back(r);
+            if (records.size() % 100 == 0) {
+                cerr << "  " << records.size() << " positions searched\n";
+            }
+            board.play(a.col, sideToMove);
+            expand(board, 1 - sideToMove, bookSide);
+            board.undo(a.col);
+        } else {
+            for (int c = 0; c < ConnectFourBoard::COLS; ++c) {
+                if (!board.canPlay(c)) continue;
+                board.play(c, sideToMove);
+                expand(board, 1 - sideToMove, bookSide);
+                board.undo(c);
+            }
+        }
+    }
+};
+
+int cmdBookGen(const vector<string>& args) {
+    if (args.empty()) {
+        cerr << "Error: book-gen needs an output file.\n";
+        return 1;
+    }
+    int plies = args.size() > 1 ? atoi(args[1].c_str()) : 8;
+    int ms = args.size() > 2 ? atoi(args[2].c_str()) : 200;
+    int threads = args.size() > 3 ? atoi(args[3].c_str()) : 0;
+    if (plies <= 0 || ms <= 0) {
+        cerr << "Error: invalid book-gen arguments.\n";
+        return 1;
+    }
+
+    ConnectFour engine(ms, 64, threads);
+    engine.setUseOpeningBook(false); // Build from search, not from an older book
+    engine.newGame();
+    BookGenerator gen{engine, plies, ms, {}, {}};
+    cerr << "Generating opening book to ply " << plies << " (" << ms << " ms per position)...\n";
+    for (int bookSide : {ConnectFourBoard::HUMAN_SIDE, ConnectFourBoard::AI_SIDE}) {
+        ConnectFourBoard board;
+        gen.visited.clear();
+        gen.expand(board, ConnectFourBoard::HUMAN_SIDE, bookSide); // HUMAN_SIDE moves first
+    }
+
+    string error;
+    if (!OpeningBook::write(args[0], gen.records, plies, error)) {
+        cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    cout << "Wrote " << gen.records.size() << " positions to " << args[0] << "\n";
+    return 0;
+}
+// --- End book-gen ---
+
+// --- analyze ---
+int cmdAnalyze(const vector<string>& args) {
+    if (args.empty()) {
+        cerr << "Error: analyze needs an input file (- for stdin).\n";
+        return 1;
+    }
+    BatchAnalyzer::Options options;
+    options.timeBudgetMs = args.size() > 1 ? atoi(args[1].c_str()) : 20;
+    options.maxDepth = args.size() > 2 ? atoi(args[2].c_str()) : 0;
+    options.threads = args.size() > 3 ? atoi(args[3].c_str()) : 0;
+    if (options.timeBudgetMs <= 0 || options.maxDepth < 0) {
+        cerr << "Error: invalid analyze arguments.\n";
+        return 1;
+    }
+
+    ifstream file;
+    if (args[0] != "-") {
+        file.open(args[0]);
+        if (!file) {
+            cerr << "Error: cannot open " << args[0] << "\n";
+            return 1;
+        }
+    }
+    ios::sync_with_stdio(false);
+    BatchAnalyzer analyzer(options);
+    BatchAnalyzer::Stats stats = analyzer.run(args[0] == "-" ? cin : file, cout);
+
+    double rate = stats.seconds > 0 ? stats.positions / stats.seconds : 0.0;
+    cerr << fixed << setprecision(1) << "Analyzed " << stats.positions << " positions (" << stats.errors
+         << " errors) in " << stats.seconds << " s: " << rate << " positions/s, "
+         << setprecision(2) << rate * 3600 / 1e6 << "M positions/hour, "
+         << setprecision(1) << (stats.seconds > 0 ? stats.nodes / stats.seconds / 1e6 : 0.0) << " Mnps\n";
+    return stats.errors ? 1 : 0;
+}
+// --- End analyze ---
+
+// --- perft ---
+// Lines are "key value" pairs for before/after comparisons:
+//   perft connectfour position 4453 depth 8 nodes 5243445 seconds 0.0312 mnps 168.06 [expected N ok|FAIL]
+template <class Board>
+bool parseColumns(const string& moves, Board& board, int& side, string& error) {
+    side = Board::HUMAN_SIDE; // HUMAN_SIDE moves first
+    for (size_t i = 0; i < moves.size(); ++i) {
+        int col = moves[i] - '1';
+        if (col < 0 || col >= Board::COLS || !board.canPlay(col)) {
+            error = "illegal move " + to_string(i + 1);
+            return false;
+        }
+        if (board.hasWon(1 - side)) {
+            error = "move " + to_string(i + 1) + " played after the game was won";
+            return false;
+        }
+        board.play(col, side);
+        side = 1 - side;
+    }
+    return true;
+}
+
+template <class Engine>
+bool perftConnect(const string& moves, int depth, uint64_t& leaves, string& error) {
+    typename Engine::Board board;
+    int side;
+    if (!parseColumns(moves, board, side, error)) return false;
+    leaves = Engine::perft(board, side, depth);
+    return true;
+}
+
+bool perftTicTacToe(const string& moves, int depth, uint64_t& leaves, string& error) {
+    const int n = TicTacToe::BOARD_SIZE;
+    TicTacToe::Position position(n, vector<char>(n, TicTacToe::EMPTY_SLOT));
+    char player = TicTacToe::HUMAN_PLAYER; // X moves first
+    for (size_t i = 0; i < moves.size(); ++i) {
+        int cell = moves[i] - '1';
+        if (cell < 0 || cell >= n * n || position[cell / n][cell % n] != TicTacToe::EMPTY_SLOT) {
+            error = "illegal move " + to_string(i + 1);
+            return false;
+        }
+        position[cell / n][cell % n] = player;
+        player = player == TicTacToe::HUMAN_PLAYER ? TicTacToe::AI_PLAYER : TicTacToe::HUMAN_PLAYER;
+    }
+    TicTacToe game;
+    leaves = game.perft(position, player, depth);
+    return true;
+}
+
+bool perft(const string& game, const string& moves, int depth, uint64_t& leaves, string& error) {
+    if (game == "connectfour") return perftConnect<ConnectFour>(moves, depth, leaves, error);
+    if (game == "connectfour8x7") return perftConnect<ConnectFour8x7>(moves, depth, leaves, error);
+#if defined(__SIZEOF_INT128__)
+    if (game == "connectfour9x7") return perftConnect<ConnectFour9x7>(moves, depth, leaves, error);
+#endif
+    if (game == "connectfive") return perftConnect<ConnectFive>(moves, depth, leaves, error);
+    if (game == "connectfour5x4") return perftConnect<ConnectFour5x4>(moves, depth, leaves, error);
+    if (game == "connectfour5x5") return perftConnect<ConnectFour5x5>(moves, depth, leaves, error);
+    if (game == "tictactoe") return perftTicTacToe(moves, depth, leaves, error);
+    error = "unknown game '" + game + "'";
+    return false;
+}
+
+// Reference counts, verified with an independent array-based implementation
+struct PerftReference {
+    const char* game;
+    const char* moves;
+    int depth;
+    uint64_t leaves;
+};
+
+const PerftReference PERFT_SUITE[] = {
+    {"connectfour", "", 9, 39394572},
+    {"connectfour", "4453321", 9, 34543210},
+    {"connectfour", "1234567123", 8, 5243445},
+    {"connectfour", "527651145461", 9, 11618091},
+    {"connectfour", "27635651771116", 10, 155677749},
+    {"connectfour8x7", "", 8, 16553656},
+    {"connectfour8x7", "45546", 8, 16508353},
+#if defined(__SIZEOF_INT128__)
+    {"connectfour9x7", "", 7, 4782969},
+    {"connectfour9x7", "551464433", 7, 4446669},
+#endif
+    {"connectfive", "", 7, 4782960},
+    {"connectfive", "55664473", 8, 27544871},
+    {"connectfour5x4", "", 10, 7738740},
+    {"connectfour5x5", "3324", 9, 1541222},
+    {"tictactoe", "", 9, 127872},
+    {"tictactoe", "51", 7, 1584},
+};
+
+bool perftLine(const string& game, const string& moves, int depth, const uint64_t* expected) {
+    uint64_t leaves = 0;
+    string error;
+    auto start = chrono::steady_clock::now();
+    if (!perft(game, moves, depth, leaves, error)) {
+        cerr << "Error: " << game << " " << moves << ": " << error << "\n";
+        return false;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    bool ok = !expected || leaves == *expected;
+    cout << fixed << "perft " << game << " position " << (moves.empty() ? "-" : moves) << " depth " << depth
+         << " nodes " << leaves << " seconds " << setprecision(4) << seconds
+         << " mnps " << setprecision(2) << (seconds > 0 ? leaves / seconds / 1e6 : 0.0);
+    if (expected) cout << " expected " << *expected << (ok ? " ok" : " FAIL");
+    cout << "\n";
+    return ok;
+}
+
+int cmdPerft(const vector<string>& args) {
+    if (args.empty()) {
+        bool ok = true;
+        for (const PerftReference& r : PERFT_SUITE) ok = perftLine(r.game, r.moves, r.depth, &r.leaves) && ok;
+        return ok ? 0 : 1;
+    }
+    int depth = args.size() > 1 ? atoi(args[1].c_str()) : 0;
+    if (depth <= 0) {
+        cerr << "Error: perft needs a game and a depth.\n";
+        return 1;
+    }
+    string moves = args.size() > 2 ? args[2] : "";
+    for (int d = 1; d <= depth; ++d) {
+        if (!perftLine(args[0], moves, d, nullptr)) return 1;
+    }
+    return 0;
+}
+// --- End perft ---
+
+// --- tablebase-gen ---
+template <class Engine>
+int generateTablebase(const vector<string>& args) {
+    using Tablebase = typename Engine::Tablebase;
+    int threads = args.size() > 1 ? atoi(args[1].c_str()) : 0;
+    int minStones = args.size() > 2 ? atoi(args[2].c_str()) : 0;
+    string path = args.size() > 3 ? args[3] : Tablebase::defaultPath();
+    cerr << "Generating " << path << ": " << Tablebase::POSITIONS << " positions, " << Tablebase::VALUE_BITS
+         << " bits each\n";
+    auto start = chrono::steady_clock::now();
+    string error;
+    if (!Tablebase::generate(path, threads, minStones, cerr, error)) {
+        cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    Tablebase table;
+    typename Tablebase::Value v;
+    if (!table.load(path)) {
+        cerr << "Error: " << path << " does not load\n";
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Wrote " << path << " down to " << table.lowestLayer() << " stones in " << fixed << setprecision(1)
+         << seconds << " s";
+    typename Engine::Board empty;
+    if (table.probe(empty, Engine::Board::HUMAN_SIDE, v)) {
+        cout << "; the first player " << (v.outcome > 0 ? "wins" : v.outcome < 0 ? "loses" : "draws")
+             << " (game length " << v.distance << " plies)";
+    }
+    cout << "\n";
+    return 0;
+}
+
+int cmdTablebaseGen(const vector<string>& args) {
+    string game = args.empty() ? "" : args[0];
+    if (game == "connectfour5x4") return generateTablebase<ConnectFour5x4>(args);
+    if (game == "connectfour5x5") return generateTablebase<ConnectFour5x5>(args);
+    cerr << "Error: tablebase-gen needs connectfour5x4 or connectfour5x5.\n";
+    return 1;
+}
+// --- End tablebase-gen ---
+
+// --- nim-solve ---
+int cmdNimSolve(const vector<string>& args) {
+    if (args.empty()) {
+        cerr << "Error: nim-solve needs an input file (- for stdin).\n";
+        return 1;
+    }
+    NimBatchSolver::Options options;
+    options.threads = args.size() > 1 ? atoi(args[1].c_str()) : 0;
+    string ending = args.size() > 2 ? args[2] : "normal";
+    if (options.threads < 0 || (ending != "normal" && ending != "misere")) {
+        cerr << "Error: invalid nim-solve arguments.\n";
+        return 1;
+    }
+    options.misere = ending == "misere";
+
+    ifstream file;
+    if (args[0] != "-") {
+        file.open(args[0], ios::binary);
+        if (!file) {
+            cerr << "Error: cannot open " << args[0] << "\n";
+            return 1;
+        }
+    }
+    ios::sync_with_stdio(false);
+    NimBatchSolver solver(options);
+    NimBatchSolver::Stats stats = solver.run(args[0] == "-" ? cin : file, cout);
+
+    double rate = stats.seconds > 0 ? stats.positions / stats.seconds : 0.0;
+    cerr << fixed << setprecision(1) << "Solved " << stats.positions << " positions (" << stats.errors
+         << " errors) in " << setprecision(3) << stats.seconds << " s: " << setprecision(0) << rate
+         << " positions/s, " << setprecision(1) << (stats.seconds > 0 ? stats.bytes / stats.seconds / 1e6 : 0.0)
+         << " MB/s\n";
+    return stats.errors ? 1 : 0;
+}
+// --- End nim-solve ---
+
+// --- maze-solve ---
+//   maze maze.txt rows 8 cols 14 algorithm jps found 1 length 15 expanded 7 pushes 9 pops 7 seconds 0.000012
+//   path 1,1 1,2 ...
+// A jps+ line also gives the seconds spent on its jump table ("table"), and
+// a bidir or bidir-threads line the cells expanded by each side ("forward",
+// "backward").
+int cmdMazeSolve(const vector<string>& args) {
+    if (args.empty()) {
+        cerr << "Error: maze-solve needs a maze file.\n";
+        return 1;
+    }
+    const pair<const char*, MazeSolver::Algorithm> ALGORITHMS[] = {
+        {"astar", MazeSolver::Algorithm::AStar}, {"jps", MazeSolver::Algorithm::JPS}, {"jps+", MazeSolver::Algorithm::JPSPlus},
+        {"bidir", MazeSolver::Algorithm::Bidirectional}, {"bidir-threads", MazeSolver::Algorithm::BidirectionalThreaded},
+    };
+    vector<size_t> chosen;
+    bool showPath = false;
+    for (size_t i = 1; i < args.size(); ++i) {
+        size_t before = chosen.size();
+        for (size_t a = 0; a < size(ALGORITHMS); ++a) {
+            if (args[i] == ALGORITHMS[a].first || args[i] == "all") chosen.push_back(a);
+        }
+        if (args[i] == "path") showPath = true;
+        else if (chosen.size() == before) {
+            cerr << "Error: invalid maze-solve arguments.\n";
+            return 1;
+        }
+    }
+    if (chosen.empty()) chosen.push_back(0);
+
+    MazeSolver maze(args[0], false);
+    if (!maze.isLoaded()) return 1; // loadMaze() gave the reason
+
+    bool found = true;
+    for (size_t a : chosen) {
+        MazeSolver::SolveResult result = maze.solve(ALGORITHMS[a].second);
+        cout << fixed << "maze " << args[0] << " rows " << maze.getRows() << " cols " << maze.getCols()
+             << " algorithm " << ALGORITHMS[a].first << " found " << result.found << " length " << result.length()
+             << " expanded " << result.expanded << " pushes " << result.heapPushes << " pops " << result.heapPops
+             << " seconds " << setprecision(6) << result.seconds;
+        if (ALGORITHMS[a].second == MazeSolver::Algorithm::JPSPlus) cout << " table " << result.tableSeconds;
+        if (ALGORITHMS[a].second == MazeSolver::Algorithm::Bidirectional ||
+            ALGORITHMS[a].second == MazeSolver::Algorithm::BidirectionalThreaded) {
+            cout << " forward " << result.expandedForward << " backward " << result.expandedBackward;
+        }
+        cout << "\n";
+        if (showPath) {
+            string line = "path";
+            for (const MazeSolver::Point& p : result.path) line += " " + to_string(p.r) + "," + to_string(p.c);
+            cout << line << "\n";
+        }
+        found = found && result.found;
+    }
+    return found ? 0 : 1;
+}
+// --- End maze-solve ---
+
+// --- maze-convert ---
+int cmdMazeConvert(const vector<string>& args) {
+    if (args.size() != 2) {
+        cerr << "Error: maze-convert needs a text maze and an output file.\n";
+        return 1;
+    }
+    auto start = chrono::steady_clock::now();
+    string error;
+    if (!MazeBitmap::convertText(args[0], args[1], error)) {
+        cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    MazeBitmap bitmap;
+    if (!bitmap.load(args[1], error)) {
+        cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << fixed << "maze " << args[1] << " rows " << bitmap.getRows() << " cols " << bitmap.getCols()
+         << " start " << bitmap.getStart().r << "," << bitmap.getStart().c << " end " << bitmap.getEnd().r << ","
+         << bitmap.getEnd().c << " seconds " << setprecision(3) << seconds << "\n";
+    return 0;
+}
+// --- End maze-convert ---
+
+// --- grundy ---
+//   game S{1,3,4} preperiod 0 period 7 seconds 0.0001
+//   grundy 1000000000 2
+int cmdGrundy(const vector<string>& args) {
+    if (args.empty()) {
+        cerr << "Error: grundy needs a move set.\n";
+        return 1;
+    }
+    vector<uint64_t> moves;
+    size_t pos = 0;
+    while (pos <= args[0].size()) {
+        size_t comma = args[0].find(',', pos);
+        if (comma == string::npos) comma = args[0].size();
+        string item = args[0].substr(pos, comma - pos);
+        if (item.empty() || item.find_first_not_of("0123456789") != string::npos) {
+            cerr << "Error: '" << args[0] << "' is not a comma-separated list of amounts.\n";
+            return 1;
+        }
+        moves.push_back(strtoull(item.c_str(), nullptr, 10));
+        pos = comma + 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    HeapGame game;
+    string error;
+    if (!HeapGame::subtraction(moves, game, error)) {
+        cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << fixed << "game " << game.describe() << " preperiod " << game.preperiod() << " period " << game.period()
+         << " seconds " << setprecision(4) << seconds << "\n";
+    for (size_t i = 1; i < args.size(); ++i) {
+        uint64_t heap = strtoull(args[i].c_str(), nullptr, 10);
+        cout << "grundy " << heap << " " << game.grundy(heap) << "\n";
+    }
+    return 0;
+}
+// --- End grundy ---
+
+// --- bench ---
+// Every position is searched from empty tables on one thread to a fixed
+// depth, so node counts are exact and only the time varies between runs:
+//   bench connectfour position 4453 depth 12 best 4 score 12 nodes 1234567 seconds 0.2500 knps 4938.27
+struct BenchPosition {
+    const char* moves;
+    int depth; // Alpha-beta plies; TicTacToe minimax always searches to the end
+};
+
+const BenchPosition CONNECT_FOUR_BENCH[] = {
+    {"", 13}, {"4453", 13}, {"44444343", 13}, {"3345566", 13}, {"4453321", 14}, {"27635651771116", 15}, {"12344321765", 14},
+};
+
+const BenchPosition TIC_TAC_TOE_BENCH[] = {
+    {"", 0}, {"1", 0}, {"5", 0}, {"59", 0},
+};
+
+void benchLine(const char* game, const string& moves, int depth, int best, int score, uint64_t nodes, double seconds) {
+    cout << fixed << "bench " << game << " position " << (moves.empty() ? "-" : moves) << " depth " << depth
+         << " best " << best << " score " << score << " nodes " << nodes << " seconds " << setprecision(4) << seconds
+         << " knps " << setprecision(2) << (seconds > 0 ? nodes / seconds / 1e3 : 0.0) << "\n";
+}
+
+int cmdBench(const vector<string>&) {
+    const int NO_TIME_LIMIT = 100000000; // Milliseconds; the depth limit ends every search
+    ConnectFour engine(NO_TIME_LIMIT, 16, 1);
+    engine.setPondering(false);
+    engine.setUseOpeningBook(false);
+    engine.setPerfectPlayThreshold(0);
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+    for (const BenchPosition& p : CONNECT_FOUR_BENCH) {
+        ConnectFourBoard board;
+        int side;
+        string error;
+        if (!parseColumns(p.moves, board, side, error)) {
+            cerr << "Error: bench position " << p.moves << ": " << error << "\n";
+            return 1;
+        }
+        engine.newGame();
+        engine.setMaxDepth(p.depth);
+        ConnectFour::Analysis a = engine.analyze(board, side, NO_TIME_LIMIT);
+        benchLine("connectfour", p.moves, a.depth, a.col + 1, a.score, a.nodes, a.seconds);
+        totalNodes += a.nodes;
+        totalSeconds += a.seconds;
+    }
+    cout << fixed << "bench connectfour total nodes " << totalNodes << " seconds " << setprecision(4) << totalSeconds
+         << " knps " << setprecision(2) << (totalSeconds > 0 ? totalNodes / totalSeconds / 1e3 : 0.0) << "\n";
+
+    TicTacToe game;
+    game.setUseMoveTable(false); // Measure the search, not the lookup
+    const int n = TicTacToe::BOARD_SIZE;
+    totalNodes = 0;
+    totalSeconds = 0.0;
+    for (const BenchPosition& p : TIC_TAC_TOE_BENCH) {
+        TicTacToe::Position position(n, vector<char>(n, TicTacToe::EMPTY_SLOT));
+        char player = TicTacToe::HUMAN_PLAYER;
+        for (const char* c = p.moves; *c; ++c) {
+            position[(*c - '1') / n][(*c - '1') % n] = player;
+            player = player == TicTacToe::HUMAN_PLAYER ? TicTacToe::AI_PLAYER : TicTacToe::HUMAN_PLAYER;
+        }
+        auto start = chrono::steady_clock::now();
+        TicTacToe::Analysis a = game.analyze(position, player);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        int empty = n * n - static_cast<int>(string(p.moves).size());
+        benchLine("tictactoe", p.moves, empty, a.row * n + a.col + 1, a.score, a.nodes, seconds);
+        totalNodes += a.nodes;
+        totalSeconds += seconds;
+    }
+    cout << fixed << "bench tictactoe total nodes " << totalNodes << " seconds " << setprecision(4) << totalSeconds
+         << " knps " << setprecision(2) << (totalSeconds > 0 ? totalNodes / totalSeconds / 1e3 : 0.0) << "\n";
+    return 0;
+}
+// --- End bench ---
+
+}
+
+int runCommandLine(int argc, char* argv[]) {
+    string command = argv[1];
+    vector<string> args(argv + 2, argv + argc);
+
+    if (command == "solve") return cmdSolve(args);
+    if (command == "solve-bench") return cmdSolveBench(args);
+    if (command == "book-gen") return cmdBookGen(args);
+    if (command == "analyze") return cmdAnalyze(args);
+    if (command == "perft") return cmdPerft(args);
+    if (command == "bench") return cmdBench(args);
+    if (command == "tablebase-gen") return cmdTablebaseGen(args);
+    if (command == "grundy") return cmdGrundy(args);
+    if (command == "nim-solve") return cmdNimSolve(args);
+    if (command == "maze-solve") return cmdMazeSolve(args);
+    if (command == "maze-convert") return cmdMazeConvert(args);
+    if (command == "tournament") return runTournament(args);
+    if (command == "help" || command == "--help" || command == "-h") {
+        printUsage();
+        return 0;
+    }
+    cerr << "Unknown command '" << command << "'.\n\n";
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,9 @@
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+// Non-interactive modes selected by command-line arguments, e.g.
+//   gamehub solve 4453 2252576253
+// Returns the process exit code. Running without arguments opens the menu.
+int runCommandLine(int argc, char* argv[]);
+
+#endif // COMMANDLINE_H
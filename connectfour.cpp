@@ -8,30 +8,94 @@
 #include <string>       // For string manipulation in getPlayerMove
 #include <thread>       // For this_thread::sleep_for
 #include <chrono>       // For chrono::milliseconds
+#include <cstdlib>      // For abs
+#include <cmath>        // For lround
 
 // Add this line after includes
 using namespace std;
 
-// --- Definitions for static const members ---
-const int ConnectFour::ROWS;
-const int ConnectFour::COLS;
-const char ConnectFour::HUMAN_PLAYER;
-const char ConnectFour::AI_PLAYER;
-const char ConnectFour::EMPTY_SLOT;
-const int ConnectFour::WIN_LENGTH;
-const int ConnectFour::MAX_DEPTH;
-// --- End definitions ---
-
-ConnectFour::ConnectFour() {
+// --- Mate score handling for the transposition table ---
+// Win/loss scores encode the distance from the search root. Stored entries are
+// made relative to the node instead, so they stay valid from any root.
+namespace {
+    const int MATE_THRESHOLD = 50000;
+
+    int scoreToTable(int score, int ply) {
+        if (score > MATE_THRESHOLD) return score + ply;
+        if (score < -MATE_THRESHOLD) return score - ply;
+        return score;
+    }
+
+    int scoreFromTable(int score, int ply) {
+        if (score > MATE_THRESHOLD) return score - ply;
+        if (score < -MATE_THRESHOLD) return score + ply;
+        return score;
+    }
+
+    // Columns from the center outwards (3, 2, 4, 1, 5, 0, 6 on seven columns),
+    // the tie-break order for move ordering
+    template <int Cols>
+    struct CenterOut {
+        int cols[Cols] = {};
+        constexpr CenterOut() {
+            for (int i = 0; i < Cols; ++i) cols[i] = Cols / 2 + (i % 2 ? -(i + 1) / 2 : i / 2);
+        }
+    };
+}
+
+template <int Rows, int Cols, int WinLength>
+BasicConnectFour<Rows, Cols, WinLength>::BasicConnectFour(int timeBudgetMs, size_t transpositionTableMB, int threadCount)
+    : timeBudgetMs(timeBudgetMs), transpositionTable(transpositionTableMB) {
     // Constructor - board initialized in play()
+    if (threadCount <= 0) threadCount = max(1, static_cast<int>(thread::hardware_concurrency()));
+    searchThreads.resize(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        searchThreads[i].id = i;
+        resetMoveOrdering(searchThreads[i]);
+    }
+    if constexpr (IS_STANDARD) {
+        solver = make_unique<ConnectFourSolver>(transpositionTableMB);
+        book.load("connectfour.book"); // Optional; built with `gamehub book-gen`
+    } else {
+        perfectPlayThreshold = 0; // The solver only knows the standard board
+    }
+    tablebase.load(Tablebase::defaultPath()); // Optional; built with `gamehub tablebase-gen`
+}
+
+template <int Rows, int Cols, int WinLength>
+string BasicConnectFour<Rows, Cols, WinLength>::getName() const {
+    string name = WIN_LENGTH == 4 ? "Connect Four" : WIN_LENGTH == 5 ? "Connect Five" : "Connect " + to_string(WIN_LENGTH);
+    if (!IS_STANDARD) name += " " + to_string(COLS) + "x" + to_string(ROWS);
+    if (engine == Engine::MCTS) name += " (MCTS)";
+    return name;
+}
+
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::setEngine(Engine e, size_t mctsArenaMB) {
+    engine = e;
+    if (engine == Engine::MCTS && !mcts) {
+        mcts = make_unique<MCTS>(mctsArenaMB, static_cast<int>(searchThreads.size()));
+    }
+}
+
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::initializeBoard() {
+    board.reset();
+    newGame();
 }
 
-void ConnectFour::initializeBoard() {
-    board.assign(ROWS, vector<char>(COLS, EMPTY_SLOT));
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::newGame() {
+    transpositionTable.clear(); // Entries are reused across moves within one game only
+    if (solver) solver->reset();
+    if (mcts) mcts->reset(); // O(1): rewinds the node arenas
+    for (SearchThread& t : searchThreads) resetMoveOrdering(t);
 }
 
+
 // --- Modified displayBoard with colors and better structure ---
-void ConnectFour::displayBoard() const {
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::displayBoard() const {
     cout << "\n";
     // Print column numbers centered above each column
     cout << " "; // Initial padding
@@ -53,7 +117,9 @@ void ConnectFour::displayBoard() const {
         cout << Color::WHITE << "║" << Color::RESET; // Left vertical border for the row
         for (int j = 0; j < COLS; ++j) {
             cout << " "; // Padding inside the cell
-            char player = board[i][j];
+            int owner = board.cellOwner(ROWS - 1 - i, j); // Row i is counted from the top
+            char player = owner == Board::AI_SIDE ? AI_PLAYER
+                        : owner == Board::HUMAN_SIDE ? HUMAN_PLAYER : EMPTY_SLOT;
             // Display player pieces with distinct colors
             if (player == HUMAN_PLAYER) {
                 cout << Color::BOLD_RED << player << Color::RESET;    // Human ('X') in Red
@@ -86,73 +152,37 @@ void ConnectFour::displayBoard() const {
 // --- End displayBoard ---
 
 
-// --- Game Logic (isValidColumn, getNextOpenRow, dropPiece, checkWin, isBoardFull, checkGameOver) - unchanged ---
-bool ConnectFour::isValidColumn(int col) const {
-    return col >= 0 && col < COLS && board[0][col] == EMPTY_SLOT;
+// --- Game Logic (isValidColumn, getNextOpenRow, dropPiece, checkWin, isBoardFull, checkGameOver) - bitboard backed ---
+template <int Rows, int Cols, int WinLength>
+bool BasicConnectFour<Rows, Cols, WinLength>::isValidColumn(int col) const {
+    return col >= 0 && col < COLS && board.canPlay(col);
 }
 
-int ConnectFour::getNextOpenRow(int col) const {
-    for (int r = ROWS - 1; r >= 0; --r) {
-        if (board[r][col] == EMPTY_SLOT) {
-            return r;
-        }
-    }
-    return -1; // Column is full
+template <int Rows, int Cols, int WinLength>
+int BasicConnectFour<Rows, Cols, WinLength>::getNextOpenRow(int col) const {
+    int r = board.nextOpenRow(col);
+    return r == -1 ? -1 : ROWS - 1 - r; // Convert to top-down row index
 }
 
-bool ConnectFour::dropPiece(int col, char player) {
-    int row = getNextOpenRow(col);
-    if (row != -1) {
-        board[row][col] = player;
-        return true;
-    }
-    return false; // Column was full
+template <int Rows, int Cols, int WinLength>
+bool BasicConnectFour<Rows, Cols, WinLength>::dropPiece(int col, char player) {
+    if (!isValidColumn(col)) return false; // Column was full
+    board.play(col, sideOf(player));
+    return true;
 }
 
-bool ConnectFour::checkWin(char player) const {
-    // Horizontal
-    for (int r = 0; r < ROWS; ++r) {
-        for (int c = 0; c <= COLS - WIN_LENGTH; ++c) {
-            bool win = true;
-            for (int k = 0; k < WIN_LENGTH; ++k) if (board[r][c + k] != player) { win = false; break; }
-            if (win) return true;
-        }
-    }
-    // Vertical
-    for (int c = 0; c < COLS; ++c) {
-        for (int r = 0; r <= ROWS - WIN_LENGTH; ++r) {
-            bool win = true;
-            for (int k = 0; k < WIN_LENGTH; ++k) if (board[r + k][c] != player) { win = false; break; }
-            if (win) return true;
-        }
-    }
-    // Positive Diagonal
-    for (int r = 0; r <= ROWS - WIN_LENGTH; ++r) {
-        for (int c = 0; c <= COLS - WIN_LENGTH; ++c) {
-            bool win = true;
-            for (int k = 0; k < WIN_LENGTH; ++k) if (board[r + k][c + k] != player) { win = false; break; }
-            if (win) return true;
-        }
-    }
-    // Negative Diagonal
-    for (int r = WIN_LENGTH - 1; r < ROWS; ++r) {
-        for (int c = 0; c <= COLS - WIN_LENGTH; ++c) {
-            bool win = true;
-            for (int k = 0; k < WIN_LENGTH; ++k) if (board[r - k][c + k] != player) { win = false; break; }
-            if (win) return true;
-        }
-    }
-    return false;
+template <int Rows, int Cols, int WinLength>
+bool BasicConnectFour<Rows, Cols, WinLength>::checkWin(char player) const {
+    return board.hasWon(sideOf(player));
 }
 
-bool ConnectFour::isBoardFull() const {
-    for (int c = 0; c < COLS; ++c) {
-        if (board[0][c] == EMPTY_SLOT) return false;
-    }
-    return true;
+template <int Rows, int Cols, int WinLength>
+bool BasicConnectFour<Rows, Cols, WinLength>::isBoardFull() const {
+    return board.isFull();
 }
 
-bool ConnectFour::checkGameOver(char& winner) {
+template <int Rows, int Cols, int WinLength>
+bool BasicConnectFour<Rows, Cols, WinLength>::checkGameOver(char& winner) {
     if (checkWin(HUMAN_PLAYER)) { winner = HUMAN_PLAYER; return true; }
     if (checkWin(AI_PLAYER)) { winner = AI_PLAYER; return true; }
     if (isBoardFull()) { winner = EMPTY_SLOT; return true; }
@@ -163,7 +193,8 @@ bool ConnectFour::checkGameOver(char& winner) {
 
 
 // --- Modified getPlayerMove with colored prompt and error messages ---
-int ConnectFour::getPlayerMove() {
+template <int Rows, int Cols, int WinLength>
+int BasicConnectFour<Rows, Cols, WinLength>::getPlayerMove() {
     int col;
     string prompt = "Player " + Color::BOLD_RED + string(1, HUMAN_PLAYER) + Color::RESET +
                     ", enter column (" + Color::CYAN + "0-" + to_string(COLS - 1) + Color::RESET + "): ";
@@ -184,13 +215,18 @@ int ConnectFour::getPlayerMove() {
 // --- End getPlayerMove ---
 
 
-// --- AI Implementation (Minimax, Heuristics) - unchanged ---
-ConnectFour::Move ConnectFour::findBestMove() {
-    int bestScore = numeric_limits<int>::min();
+// --- AI Implementation (Minimax, MCTS, Heuristics) on the bitboard ---
+// Immediate wins and blocks, the opening book and the endgame solver come
+// first; everything else goes to the selected engine.
+template <int Rows, int Cols, int WinLength>
+auto BasicConnectFour<Rows, Cols, WinLength>::findBestMove(int timeBudgetMs) -> Move {
+    const int ai = Board::AI_SIDE;
+    const int human = Board::HUMAN_SIDE;
     Move bestMove;
     bestMove.col = -1;
-    int alpha = numeric_limits<int>::min();
-    int beta = numeric_limits<int>::max();
+    lastSearch = SearchStats();
+    PonderResult pondered = ponderHit; // Only valid for this move
+    ponderHit = PonderResult();
 
     vector<int> possibleMoves;
     for (int c = 0; c < COLS; ++c) {
@@ -198,193 +234,563 @@ ConnectFour::Move ConnectFour::findBestMove() {
             possibleMoves.push_back(c);
         }
     }
+    if (possibleMoves.empty()) return bestMove;
 
     // Basic heuristic: Check for immediate win first
     for (int c : possibleMoves) {
-         int r = getNextOpenRow(c);
-         board[r][c] = AI_PLAYER;
-         if (checkWin(AI_PLAYER)) {
-             board[r][c] = EMPTY_SLOT; // Undo test move
+         if (board.isWinningMove(c, ai)) {
              bestMove.col = c;
              bestMove.score = 1000000; // Assign immediate win highest score
              return bestMove;
          }
-         board[r][c] = EMPTY_SLOT; // Undo test move
-    }
-     // Basic heuristic: Check for immediate block of opponent win
-     for (int c : possibleMoves) {
-         int r = getNextOpenRow(c);
-         board[r][c] = HUMAN_PLAYER; // Temporarily place opponent's piece
-         if (checkWin(HUMAN_PLAYER)) {
-             board[r][c] = EMPTY_SLOT; // Undo test move
-             bestMove.col = c; // Choose this column to block
-             bestScore = 90000; // High score for blocking, but less than winning
-             // Don't return immediately, check if other moves might be better via minimax
-             goto evaluate_other_moves; // Jump to minimax evaluation
+    }
+    // Basic heuristic: Check for immediate block of opponent win
+    Move blockMove;
+    for (int c : possibleMoves) {
+         if (board.isWinningMove(c, human)) {
+             blockMove.col = c; // Choose this column to block
+             blockMove.score = 90000; // High score for blocking, but less than winning
+             break;
          }
-         board[r][c] = EMPTY_SLOT; // Undo test move
-     }
-
+    }
 
-evaluate_other_moves:
-    // If no immediate win/block found or if block score needs comparison
-    int currentBestScore = (bestMove.col != -1) ? bestScore : numeric_limits<int>::min();
-    if(bestMove.col == -1) bestScore = numeric_limits<int>::min(); // Reset if no block was found
+    // Positions the tablebase covers need no search at all
+    int tablebaseCol;
+    typename Tablebase::Value exact;
+    if (tablebase.bestMove(board, ai, tablebaseCol, exact)) {
+        lastSearch.fromTablebase = true;
+        lastSearch.completedDepth = exact.distance;
+        bestMove.col = tablebaseCol;
+        bestMove.score = exact.outcome > 0 ? 100000 - exact.distance
+                       : exact.outcome < 0 ? -100000 + exact.distance : 0;
+        return bestMove;
+    }
 
-    for (int c : possibleMoves) {
-        int r = getNextOpenRow(c);
-        board[r][c] = AI_PLAYER;
-        int score = minimaxAlphaBeta(0, numeric_limits<int>::min(), numeric_limits<int>::max(), false); // Reset alpha/beta for each top-level move
-        board[r][c] = EMPTY_SLOT; // Undo move
+    if constexpr (IS_STANDARD) {
+        // Opening: instant book move
+        int bookCol, bookScore;
+        if (useBook && board.moveCount() <= book.maxPly() &&
+            book.lookup(board.sideMask(ai), board.occupiedMask(), bookCol, bookScore) && board.canPlay(bookCol)) {
+            lastSearch.fromBook = true;
+            bestMove.col = bookCol;
+            bestMove.score = bookScore;
+            return bestMove;
+        }
 
-        if (bestMove.col == -1 || score > bestScore) { // If first move or better score
-             bestScore = score;
-             bestMove.col = c;
+        // Endgame: few enough empty cells to solve exactly
+        if (ROWS * COLS - board.moveCount() <= perfectPlayThreshold) {
+            ConnectFourSolver::Result solved = solver->solve(board, ai);
+            lastSearch.solved = true;
+            lastSearch.completedDepth = solved.distance;
+            lastSearch.nodes = solved.nodes;
+            lastSearch.seconds = solved.seconds;
+            bestMove.col = solved.bestMove;
+            bestMove.score = solved.score > 0 ? 100000 - solved.distance
+                           : solved.score < 0 ? -100000 + solved.distance : 0;
+            return bestMove;
         }
     }
 
+    bestMove = engine == Engine::MCTS ? searchMCTS(timeBudgetMs) : searchAlphaBeta(timeBudgetMs, pondered);
+
+    // Block the opponent's immediate win unless the search found a forced win
+    if (blockMove.col != -1 && bestMove.score <= blockMove.score) {
+        bestMove = blockMove;
+    }
+
      // Fallback if something went wrong
-     if (bestMove.col == -1 && !possibleMoves.empty()) {
+     if (bestMove.col == -1) {
          bestMove.col = possibleMoves[possibleMoves.size() / 2]; // Prefer center column as fallback
-         if (!isValidColumn(bestMove.col)) bestMove.col = possibleMoves[0]; // Or just first available
      }
+    return bestMove;
+}
+
+// Iterative deepening with Lazy SMP: every thread runs its own deepening loop
+// on a private board copy and all of them share the transposition table.
+// Thread 0 owns the clock and the returned move; helpers start one ply deeper
+// on odd ids and rotate their root move order, so they fill the table with
+// results thread 0 has not reached yet.
+template <int Rows, int Cols, int WinLength>
+auto BasicConnectFour<Rows, Cols, WinLength>::searchAlphaBeta(int timeBudgetMs, const PonderResult& pondered) -> Move {
+    Move bestMove;
+    // Prepare every thread: fresh root copy, cleared counters, aged history
+    for (SearchThread& t : searchThreads) {
+        t.board = board;
+        t.eval.reset(board);
+        t.rootRotation = t.id;
+        t.nodes = t.expandedNodes = t.betaCutoffs = t.firstMoveCutoffs = 0;
+        t.ttHits = t.ttMisses = t.tablebaseHits = 0;
+        // Killers are per ply from the root, so they do not carry over
+        for (auto& k : t.killers) k[0] = k[1] = -1;
+        for (auto& side : t.history) for (int& h : side) h /= 2;
+    }
+
+    auto start = chrono::steady_clock::now();
+    deadline = start + chrono::milliseconds(timeBudgetMs);
+    stopSearch = false;
+
+    vector<thread> helpers;
+    vector<Move> helperMoves(searchThreads.size());
+    vector<int> helperDepths(searchThreads.size());
+    for (size_t i = 1; i < searchThreads.size(); ++i) {
+        helpers.emplace_back([this, i, &helperMoves, &helperDepths] {
+            iterativeDeepening(searchThreads[i], helperMoves[i], helperDepths[i]);
+        });
+    }
+    iterativeDeepening(searchThreads[0], bestMove, lastSearch.completedDepth);
+    stopSearch = true;
+    for (thread& h : helpers) h.join();
+
+    lastSearch.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    for (const SearchThread& t : searchThreads) {
+        lastSearch.nodes += t.nodes;
+        lastSearch.expandedNodes += t.expandedNodes;
+        lastSearch.betaCutoffs += t.betaCutoffs;
+        lastSearch.firstMoveCutoffs += t.firstMoveCutoffs;
+        lastSearch.ttHits += t.ttHits;
+        lastSearch.ttMisses += t.ttMisses;
+        lastSearch.tablebaseHits += t.tablebaseHits;
+    }
 
-    bestMove.score = bestScore;
+    // Pondering may already have searched this position deeper
+    if (pondered.depth > lastSearch.completedDepth) {
+        bestMove = pondered.move;
+        lastSearch.completedDepth = pondered.depth;
+        lastSearch.fromPonder = true;
+    }
     return bestMove;
 }
 
-int ConnectFour::minimaxAlphaBeta(int depth, int alpha, int beta, bool isMaximizingPlayer) {
-    char winner;
-    if (checkGameOver(winner)) {
-        if (winner == AI_PLAYER) return 100000 - depth; // Faster wins are better
-        if (winner == HUMAN_PLAYER) return -100000 + depth; // Slower losses are better
-        return 0; // Draw
+// MCTS from the current board for AI_SIDE. The score is the expected result
+// of the chosen move scaled to -1000 (certain loss) .. 1000 (certain win).
+template <int Rows, int Cols, int WinLength>
+auto BasicConnectFour<Rows, Cols, WinLength>::searchMCTS(int timeBudgetMs) -> Move {
+    typename MCTS::Result r = mcts->search(board, Board::AI_SIDE, timeBudgetMs);
+    lastSearch.mcts = true;
+    lastSearch.completedDepth = r.maxDepth;
+    lastSearch.nodes = r.playouts;
+    lastSearch.seconds = r.seconds;
+    lastSearch.winRate = r.winRate;
+    lastSearch.bestVisits = r.bestVisits;
+    lastSearch.reusedVisits = r.reusedVisits;
+    lastSearch.treeNodes = r.treeNodes;
+
+    Move bestMove;
+    bestMove.col = r.col;
+    bestMove.score = static_cast<int>(lround((2.0 * r.winRate - 1.0) * 1000));
+    return bestMove;
+}
+
+// Counts legal moves in bulk at the last ply; a win earlier ends its branch
+template <int Rows, int Cols, int WinLength>
+uint64_t BasicConnectFour<Rows, Cols, WinLength>::perft(Board& position, int sideToMove, int depth) {
+    if (depth == 0) return 1;
+    uint64_t leaves = 0;
+    for (int col = 0; col < COLS; ++col) {
+        if (!position.canPlay(col)) continue;
+        if (depth == 1) { // Bulk count: every legal move is a leaf
+            ++leaves;
+            continue;
+        }
+        if (position.isWinningMove(col, sideToMove)) continue;
+        position.play(col, sideToMove);
+        leaves += perft(position, 1 - sideToMove, depth - 1);
+        position.undo(col);
     }
-    if (depth >= MAX_DEPTH) return evaluateBoard();
+    return leaves;
+}
 
-    vector<int> possibleMoves;
-    for (int c = 0; c < COLS; ++c) if (isValidColumn(c)) possibleMoves.push_back(c);
+// Analyzes an arbitrary position. The engine always searches for AI_SIDE, so
+// positions with the other side to move are searched with colors exchanged.
+template <int Rows, int Cols, int WinLength>
+auto BasicConnectFour<Rows, Cols, WinLength>::analyze(const Board& position, int sideToMove, int timeBudgetMs) -> Analysis {
+    Board saved = board;
+    board = (sideToMove == Board::AI_SIDE) ? position : position.swapped();
+    Move m = findBestMove(timeBudgetMs);
+    board = saved;
+
+    Analysis a;
+    a.col = m.col;
+    a.score = m.score;
+    a.depth = lastSearch.completedDepth;
+    a.nodes = lastSearch.nodes;
+    a.seconds = lastSearch.seconds;
+    a.fromBook = lastSearch.fromBook;
+    a.solved = lastSearch.solved;
+    return a;
+}
+
+// Search 1, 2, 3... plies until stopped, keeping the best move of the last
+// iteration that finished. Aspiration windows around the previous score are
+// widened on fail low/high.
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::iterativeDeepening(SearchThread& t, Move& bestMove, int& completedDepth) {
+    int maxDepth = ROWS * COLS - t.board.moveCount(); // No point searching past a full board
+    if (depthLimit > 0) maxDepth = min(maxDepth, depthLimit);
+    int prevScore = 0;
+    completedDepth = 0;
+
+    for (int depth = 1 + (t.id % 2); depth <= maxDepth; ++depth) {
+        Move result;
+        if (completedDepth == 0) {
+            result = searchRoot(t, depth, numeric_limits<int>::min(), numeric_limits<int>::max(), bestMove.col);
+        } else {
+            int alpha = prevScore - ASPIRATION_WINDOW;
+            int beta = prevScore + ASPIRATION_WINDOW;
+            result = searchRoot(t, depth, alpha, beta, bestMove.col);
+            if (!stopSearch && result.score <= alpha) {
+                result = searchRoot(t, depth, numeric_limits<int>::min(), beta, bestMove.col);
+            }
+            if (!stopSearch && result.score >= beta) {
+                result = searchRoot(t, depth, numeric_limits<int>::min(), numeric_limits<int>::max(), bestMove.col);
+            }
+        }
+        if (stopSearch && completedDepth > 0) break; // Keep the last completed iteration's move
+
+        bestMove = result;
+        prevScore = result.score;
+        completedDepth = depth;
+        if (stopSearch) break;
+        if (abs(result.score) > MATE_THRESHOLD) break; // Forced result found
+        if (t.id == 0 && chrono::steady_clock::now() >= deadline) break;
+    }
+}
+
+// One root iteration: AI moves at the root (maximizing), `firstCol` is tried first
+template <int Rows, int Cols, int WinLength>
+auto BasicConnectFour<Rows, Cols, WinLength>::searchRoot(SearchThread& t, int depth, int alpha, int beta, int firstCol) -> Move {
+    Move best;
+    best.score = numeric_limits<int>::min();
+    t.searchDepth = depth;
+
+    int order[COLS];
+    int n = orderMoves(t, 0, Board::AI_SIDE, firstCol, order);
+    if (t.rootRotation > 0 && n > 1) {
+        // Helper threads perturb the root order so they explore different subtrees first
+        rotate(order + 1, order + 1 + (t.rootRotation % (n - 1)), order + n);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int c = order[i];
+        int bit = t.play(c, Board::AI_SIDE);
+        int score = minimaxAlphaBeta(t, 1, alpha, beta, false);
+        t.undo(c, bit, Board::AI_SIDE);
+        if (stopSearch && best.col != -1) break;
+
+        if (score > best.score) {
+            best.score = score;
+            best.col = c;
+        }
+        alpha = max(alpha, score);
+        if (beta <= alpha) break;
+    }
+    return best;
+}
+
+template <int Rows, int Cols, int WinLength>
+int BasicConnectFour<Rows, Cols, WinLength>::minimaxAlphaBeta(SearchThread& t, int depth, int alpha, int beta, bool isMaximizingPlayer) {
+    // Thread 0 polls the clock every 1024 nodes; an aborted iteration is discarded
+    if ((++t.nodes & 1023) == 0 && t.id == 0 && chrono::steady_clock::now() >= deadline) {
+        stopSearch = true;
+    }
+    if (stopSearch.load(memory_order_relaxed)) return 0;
+
+    const Board& position = t.board;
+    // Only the side that just moved can have completed a line
+    if (isMaximizingPlayer ? position.hasWon(Board::HUMAN_SIDE) : position.hasWon(Board::AI_SIDE)) {
+        return isMaximizingPlayer ? -100000 + depth  // Slower losses are better
+                                  : 100000 - depth;  // Faster wins are better
+    }
+    if (position.isFull()) return 0; // Draw
+    const int side = isMaximizingPlayer ? Board::AI_SIDE : Board::HUMAN_SIDE;
+
+    // Tablebase: exact value, even at the horizon
+    typename Tablebase::Value exact;
+    if (tablebase.probe(position, side, exact)) {
+        ++t.tablebaseHits;
+        if (exact.outcome == 0) return 0;
+        const int end = depth + exact.distance; // Ply of the winning move
+        return (exact.outcome > 0) == isMaximizingPlayer ? 100000 - end : -100000 + end;
+    }
+    if (depth >= t.searchDepth) return t.eval.score(); // Heuristic (incremental window counts)
+
+    // Transposition table lookup
+    const int remaining = t.searchDepth - depth;
+    const uint64_t key = position.hash(side);
+    TranspositionTable::Entry entry;
+    int ttMove = -1;
+    if (transpositionTable.probe(key, entry)) {
+        ++t.ttHits;
+        ttMove = entry.bestMove;
+        if (entry.depth >= remaining) {
+            int ttScore = scoreFromTable(entry.score, depth);
+            if (entry.bound == TranspositionTable::BOUND_EXACT) return ttScore;
+            if (entry.bound == TranspositionTable::BOUND_LOWER) alpha = max(alpha, ttScore);
+            if (entry.bound == TranspositionTable::BOUND_UPPER) beta = min(beta, ttScore);
+            if (beta <= alpha) return ttScore;
+        }
+    } else {
+        ++t.ttMisses;
+    }
+    const int alphaOrig = alpha;
+    const int betaOrig = beta;
+    int bestCol = -1;
+    int order[COLS];
+    const int moveCount = orderMoves(t, depth, side, ttMove, order);
+    ++t.expandedNodes;
 
     if (isMaximizingPlayer) { // AI's Turn (O)
         int maxEval = numeric_limits<int>::min();
-        for (int c : possibleMoves) {
-            int r = getNextOpenRow(c);
-            board[r][c] = AI_PLAYER;
-            int eval = minimaxAlphaBeta(depth + 1, alpha, beta, false);
-            board[r][c] = EMPTY_SLOT;
-            maxEval = max(maxEval, eval);
+        for (int i = 0; i < moveCount; ++i) {
+            int c = order[i];
+            int bit = t.play(c, Board::AI_SIDE);
+            int eval = minimaxAlphaBeta(t, depth + 1, alpha, beta, false);
+            t.undo(c, bit, Board::AI_SIDE);
+            if (stopSearch.load(memory_order_relaxed)) return 0;
+            if (eval > maxEval) { maxEval = eval; bestCol = c; }
             alpha = max(alpha, eval);
-            if (beta <= alpha) break; // Beta cutoff
+            if (beta <= alpha) { // Beta cutoff
+                recordCutoff(t, depth, side, c, remaining, i);
+                break;
+            }
         }
+        TranspositionTable::Bound bound = maxEval <= alphaOrig ? TranspositionTable::BOUND_UPPER
+                                        : maxEval >= betaOrig ? TranspositionTable::BOUND_LOWER
+                                        : TranspositionTable::BOUND_EXACT;
+        transpositionTable.store(key, remaining, scoreToTable(maxEval, depth), bound, bestCol);
         return maxEval;
     } else { // Human's Turn (X)
         int minEval = numeric_limits<int>::max();
-        for (int c : possibleMoves) {
-            int r = getNextOpenRow(c);
-            board[r][c] = HUMAN_PLAYER;
-            int eval = minimaxAlphaBeta(depth + 1, alpha, beta, true);
-            board[r][c] = EMPTY_SLOT;
-            minEval = min(minEval, eval);
+        for (int i = 0; i < moveCount; ++i) {
+            int c = order[i];
+            int bit = t.play(c, Board::HUMAN_SIDE);
+            int eval = minimaxAlphaBeta(t, depth + 1, alpha, beta, true);
+            t.undo(c, bit, Board::HUMAN_SIDE);
+            if (stopSearch.load(memory_order_relaxed)) return 0;
+            if (eval < minEval) { minEval = eval; bestCol = c; }
             beta = min(beta, eval);
-            if (beta <= alpha) break; // Alpha cutoff
+            if (beta <= alpha) { // Alpha cutoff
+                recordCutoff(t, depth, side, c, remaining, i);
+                break;
+            }
         }
+        TranspositionTable::Bound bound = minEval >= betaOrig ? TranspositionTable::BOUND_LOWER
+                                        : minEval <= alphaOrig ? TranspositionTable::BOUND_UPPER
+                                        : TranspositionTable::BOUND_EXACT;
+        transpositionTable.store(key, remaining, scoreToTable(minEval, depth), bound, bestCol);
         return minEval;
     }
 }
 
-int ConnectFour::evaluateBoard() const {
-    int score = 0;
-    // Center column control heuristic
-    for(int r = 0; r < ROWS; ++r) {
-        if (board[r][COLS / 2] == AI_PLAYER) score += 3;
-        else if (board[r][COLS / 2] == HUMAN_PLAYER) score -= 3;
-    }
-
-    // Horizontal, Vertical, Diagonal scoring
-    auto checkLines = [&](int dr, int dc) {
-        int current_score = 0;
-        for (int r = 0; r < ROWS; ++r) {
-            for (int c = 0; c < COLS; ++c) {
-                vector<char> line;
-                bool possible = true;
-                for (int k = 0; k < WIN_LENGTH; ++k) {
-                    int nr = r + k * dr;
-                    int nc = c + k * dc;
-                    if (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS) {
-                         line.push_back(board[nr][nc]);
-                    } else { possible = false; break; }
-                }
-                 if (possible && line.size() == WIN_LENGTH) {
-                     current_score += scoreLine(line, AI_PLAYER);
-                     current_score -= scoreLine(line, HUMAN_PLAYER); // Subtract opponent's score potential
-                 }
-            }
+// --- Pondering ---
+// During the human's turn the engine keeps searching in the background.
+// MCTS grows its tree from the current position with the human to move; the
+// next search walks its root down the human's move and keeps that subtree.
+// Alpha-beta searches its answer to every possible human reply (see
+// ponderAlphaBeta()); the answer to the reply actually played is used if it
+// is deeper than the AI's own search, and the shared transposition table
+// makes that search fast either way.
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::startPondering() {
+    if (!pondering || ponderThread.joinable()) return;
+    // The exact solver takes over next move; it has its own table
+    if (IS_STANDARD && ROWS * COLS - board.moveCount() - 1 <= perfectPlayThreshold) return;
+
+    stopSearch = false; // Cleared here, not in the thread, so an early stop cannot be lost
+    ponderStart = chrono::steady_clock::now();
+    ponderThread = thread([this] {
+        if (engine == Engine::MCTS) {
+            mcts->search(board, Board::HUMAN_SIDE, numeric_limits<int>::max(), &stopSearch);
+        } else {
+            ponderAlphaBeta();
         }
-        return current_score;
-    };
-
-    score += checkLines(0, 1); // Horizontal
-    score += checkLines(1, 0); // Vertical
-    score += checkLines(1, 1); // Positive Diagonal (/)
-
-    // Negative Diagonal (\) - Adjusted check
-     int neg_diag_score = 0;
-     for (int r = WIN_LENGTH - 1; r < ROWS; ++r) {
-         for (int c = 0; c <= COLS - WIN_LENGTH; ++c) {
-             vector<char> line;
-             for (int k = 0; k < WIN_LENGTH; ++k) line.push_back(board[r-k][c+k]);
-             neg_diag_score += scoreLine(line, AI_PLAYER);
-             neg_diag_score -= scoreLine(line, HUMAN_PLAYER);
-         }
-     }
-     score += neg_diag_score;
-
-    return score;
+    });
 }
 
-int ConnectFour::scoreLine(const vector<char>& line, char player) const {
-    int score = 0;
-    int playerCount = 0;
-    int emptyCount = 0;
-    char opponent = (player == AI_PLAYER) ? HUMAN_PLAYER : AI_PLAYER;
-    int opponentCount = 0;
+template <int Rows, int Cols, int WinLength>
+int BasicConnectFour<Rows, Cols, WinLength>::stopPondering() {
+    if (!ponderThread.joinable()) return 0;
+    stopSearch = true;
+    ponderThread.join();
+    auto elapsed = chrono::steady_clock::now() - ponderStart;
+    return static_cast<int>(chrono::duration_cast<chrono::milliseconds>(elapsed).count());
+}
 
-    for (char slot : line) {
-        if (slot == player) playerCount++;
-        else if (slot == EMPTY_SLOT) emptyCount++;
-        else opponentCount++;
+// Iterative deepening over all human replies at once: task k searches reply
+// k % n to depth k / n + 1, so every reply reaches depth d before any reaches
+// d + 1. Threads take tasks from a shared counter and share the table.
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::ponderAlphaBeta() {
+    for (PonderResult& r : ponderResults) r = PonderResult();
+    int replies[COLS];
+    int n = 0;
+    for (int c = 0; c < COLS; ++c) {
+        // Replies that end the game leave nothing for the AI to answer
+        if (board.canPlay(c) && !board.isWinningMove(c, Board::HUMAN_SIDE)) replies[n++] = c;
+    }
+    const int maxDepth = ROWS * COLS - board.moveCount() - 1;
+    if (n == 0 || maxDepth <= 0) return;
+    deadline = chrono::steady_clock::time_point::max(); // Only stopSearch ends pondering
+
+    atomic<int> nextTask{0};
+    auto work = [this, &nextTask, &replies, n, maxDepth](SearchThread& t) {
+        t.rootRotation = 0; // Threads already work on different tasks
+        while (!stopSearch) {
+            int task = nextTask++;
+            int depth = task / n + 1;
+            int col = replies[task % n];
+            if (depth > maxDepth) break;
+
+            PonderResult prev;
+            {
+                lock_guard<mutex> lock(ponderMutex);
+                prev = ponderResults[col];
+            }
+            if (prev.depth >= depth || (prev.depth > 0 && abs(prev.move.score) > MATE_THRESHOLD)) continue;
+
+            t.board = board;
+            t.board.play(col, Board::HUMAN_SIDE);
+            t.eval.reset(t.board);
+            for (auto& k : t.killers) k[0] = k[1] = -1;
+            Move m = searchRoot(t, depth, numeric_limits<int>::min(), numeric_limits<int>::max(), prev.move.col);
+            if (stopSearch) break; // Interrupted iterations are discarded
+
+            lock_guard<mutex> lock(ponderMutex);
+            if (depth > ponderResults[col].depth) {
+                ponderResults[col].move = m;
+                ponderResults[col].depth = depth;
+            }
+        }
+    };
+    vector<thread> helpers;
+    for (size_t i = 1; i < searchThreads.size(); ++i) {
+        helpers.emplace_back([this, i, &work] { work(searchThreads[i]); });
     }
-    // Give no score if opponent is blocking the line
-    if (opponentCount > 0) return 0;
+    work(searchThreads[0]);
+    for (thread& h : helpers) h.join();
+}
+// --- End Pondering ---
+
+// --- Move Ordering ---
+// Order: transposition/PV move, the two killers for this ply, then history
+// score, with center-outward column order breaking ties.
+template <int Rows, int Cols, int WinLength>
+int BasicConnectFour<Rows, Cols, WinLength>::orderMoves(const SearchThread& t, int ply, int side, int ttMove, int order[COLS]) const {
+    static constexpr CenterOut<COLS> CENTER_OUT{};
+    int keys[COLS];
+    int n = 0;
+    for (int i = 0; i < COLS; ++i) {
+        int c = CENTER_OUT.cols[i];
+        if (!t.board.canPlay(c)) continue;
+        int key;
+        if (c == ttMove) key = 1 << 30;
+        else if (c == t.killers[ply][0]) key = 1 << 29;
+        else if (c == t.killers[ply][1]) key = 1 << 28;
+        else key = t.history[side][Board::bitIndex(t.board.moveBit(c))];
+        // Insertion sort, stable so center-out order wins ties
+        int j = n++;
+        while (j > 0 && keys[j - 1] < key) {
+            keys[j] = keys[j - 1];
+            order[j] = order[j - 1];
+            --j;
+        }
+        keys[j] = key;
+        order[j] = c;
+    }
+    return n;
+}
 
-    // Assign scores based on player's pieces
-    if (playerCount == 4) score = 10000;  // Win
-    else if (playerCount == 3 && emptyCount == 1) score = 100;  // Threaten win (3 in a row)
-    else if (playerCount == 2 && emptyCount == 2) score = 10;   // Potential (2 in a row)
-    else if (playerCount == 1 && emptyCount == 3) score = 1;    // Slight potential
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::recordCutoff(SearchThread& t, int ply, int side, int col, int remaining, int moveIndex) {
+    ++t.betaCutoffs;
+    if (moveIndex == 0) ++t.firstMoveCutoffs;
+    if (t.killers[ply][0] != col) {
+        t.killers[ply][1] = t.killers[ply][0];
+        t.killers[ply][0] = col;
+    }
+    int& h = t.history[side][Board::bitIndex(t.board.moveBit(col))];
+    h = min(h + remaining * remaining, 1 << 27); // Stay below the killer keys
+}
 
-    return score;
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::resetMoveOrdering(SearchThread& t) {
+    for (auto& k : t.killers) k[0] = k[1] = -1;
+    for (auto& side : t.history) for (int& h : side) h = 0;
+}
+// --- End Move Ordering ---
+
+// Search statistics for the last AI move
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::displaySearchStats() const {
+    const SearchStats& st = lastSearch;
+    if (st.ponderSeconds >= 0.05) {
+        cout << Color::WHITE << "AI pondered " << fixed << setprecision(1) << st.ponderSeconds
+             << "s during your turn" << Color::RESET << "\n";
+    }
+    if (st.fromBook) {
+        cout << Color::WHITE << "AI move from opening book (" << book.size() << " positions)" << Color::RESET << "\n";
+        return;
+    }
+    if (st.fromTablebase) {
+        cout << Color::WHITE << "AI tablebase: exact result, game ends within " << st.completedDepth << " plies"
+             << Color::RESET << "\n";
+        return;
+    }
+    if (st.solved) {
+        cout << Color::WHITE << "AI solver: exact result, game ends within " << st.completedDepth << " plies, "
+             << st.nodes << " nodes in " << fixed << setprecision(3) << st.seconds << "s" << Color::RESET << "\n";
+        return;
+    }
+    if (st.mcts) {
+        double rate = st.seconds > 0 ? st.nodes / st.seconds : 0.0;
+        cout << Color::WHITE << "AI MCTS: " << st.nodes << " playouts (" << fixed << setprecision(1) << rate / 1e3
+             << "k/s, " << mcts->threadCount() << " threads), best move " << st.bestVisits << " visits, win rate "
+             << 100.0 * st.winRate << "% | tree " << st.treeNodes << " nodes x " << MCTS::bytesPerNode()
+             << " B, depth " << st.completedDepth << ", " << st.reusedVisits << " visits reused"
+             << Color::RESET << "\n";
+        return;
+    }
+    uint64_t probes = st.ttHits + st.ttMisses;
+    double hitRate = probes ? 100.0 * st.ttHits / probes : 0.0;
+    double nps = st.seconds > 0 ? st.nodes / st.seconds : 0.0;
+    cout << Color::WHITE << "AI search: depth " << st.completedDepth << (st.fromPonder ? " (pondered)" : "")
+         << ", " << st.nodes << " nodes ("
+         << fixed << setprecision(1) << nps / 1e6 << " Mnps, " << searchThreads.size() << " threads) | TT "
+         << st.ttHits << " hits / " << st.ttMisses << " misses (" << hitRate << "%), "
+         << transpositionTable.sizeBytes() / (1024 * 1024) << " MB";
+    if (st.tablebaseHits > 0) cout << " | tablebase " << st.tablebaseHits << " hits";
+    if (st.betaCutoffs > 0) {
+        cout << " | cutoffs " << 100.0 * st.betaCutoffs / st.expandedNodes << "% (first move "
+             << 100.0 * st.firstMoveCutoffs / st.betaCutoffs << "%)";
+    }
+    cout << Color::RESET << "\n";
 }
 // --- End AI Implementation ---
 
 
 // --- Modified Main Play Loop with UI enhancements ---
-void ConnectFour::play() {
+template <int Rows, int Cols, int WinLength>
+void BasicConnectFour<Rows, Cols, WinLength>::play() {
     initializeBoard();
     char currentPlayer = HUMAN_PLAYER;
     char winner = ' ';
     bool gameOver = false;
+    int ponderedMs = 0; // Background search time before the AI's current move
 
     while (!gameOver) {
         clearScreen();
-        cout << Color::BOLD_YELLOW << "=== Connect Four ===\n" << Color::RESET;
+        cout << Color::BOLD_YELLOW << "=== " << getName() << " ===\n" << Color::RESET;
         displayBoard(); // Display board with new UI
+        if (board.moveCount() > 1) displaySearchStats();
 
         string status;
         if (currentPlayer == HUMAN_PLAYER) {
             status = "Your turn (Player " + Color::BOLD_RED + HUMAN_PLAYER + Color::RESET + ")";
             cout << status << "\n";
+            startPondering(); // Search on while the human thinks
             int col = getPlayerMove(); // Get validated move
+            ponderedMs = stopPondering();
+            if (ponderedMs > 0 && engine == Engine::AlphaBeta) ponderHit = ponderResults[col];
             if (!dropPiece(col, HUMAN_PLAYER)) {
                 // This block should ideally not be reached due to getPlayerMove validation
                  cout << Color::BOLD_RED << "Internal Error: Failed to drop piece in valid column " << col << ".\n" << Color::RESET;
@@ -395,9 +801,13 @@ void ConnectFour::play() {
             status = "AI's turn (" + Color::BOLD_YELLOW + AI_PLAYER + Color::RESET + ")... Thinking...";
             cout << status << "\n";
             cout.flush(); // Ensure message displays before potential delay
-            this_thread::sleep_for(chrono::milliseconds(500)); // Simulate thinking
+            if (!pondering) this_thread::sleep_for(chrono::milliseconds(500)); // Simulate thinking
 
-            Move aiMove = findBestMove();
+            // Time spent pondering counts towards this move
+            int budget = ponderedMs > 0 ? max(MIN_REPLY_MS, timeBudgetMs - ponderedMs) : timeBudgetMs;
+            Move aiMove = findBestMove(budget);
+            lastSearch.ponderSeconds = ponderedMs / 1000.0;
+            ponderedMs = 0;
 
             if (aiMove.col != -1 && dropPiece(aiMove.col, AI_PLAYER)) {
                 // Optional: Give feedback on AI's move right after it happens
@@ -425,8 +835,9 @@ void ConnectFour::play() {
 
     // --- Game Over Section ---
     clearScreen();
-    cout << Color::BOLD_YELLOW << "=== Connect Four: Game Over ===\n" << Color::RESET;
+    cout << Color::BOLD_YELLOW << "=== " << getName() << ": Game Over ===\n" << Color::RESET;
     displayBoard(); // Show the final board state
+    displaySearchStats();
 
     // Display colored result message
     if (winner == HUMAN_PLAYER) {
@@ -440,4 +851,15 @@ void ConnectFour::play() {
 
     // Pause handled by main.cpp loop
 }
-// --- End play() function ---
\ No newline at end of file
+// --- End play() function ---
+
+// --- Explicit instantiations (see the aliases in connectfour.h) ---
+template class BasicConnectFour<6, 7, 4>;
+template class BasicConnectFour<7, 8, 4>;
+#if defined(__SIZEOF_INT128__)
+template class BasicConnectFour<7, 9, 4>;
+#endif
+template class BasicConnectFour<6, 9, 5>;
+template class BasicConnectFour<4, 5, 4>;
+template class BasicConnectFour<5, 5, 4>;
+// --- End explicit instantiations ---
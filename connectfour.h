@@ -2,28 +2,119 @@
 #define CONNECTFOUR_H
 
 #include "game.h"
+#include "connectfourboard.h"
+#include "connectfourevaluator.h"
+#include "connectfourmcts.h"
+#include "connectfoursolver.h"
+#include "openingbook.h"
+#include "tablebase.h"
+#include "transpositiontable.h"
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 
-class ConnectFour : public Game {
+// Connect Four engine and game for a Rows x Cols board with WinLength in a
+// row. Everything geometry-dependent (bitboard masks, shifts, window tables,
+// move order) is a compile-time constant of the instantiation; the members
+// are defined in connectfour.cpp and instantiated there for the supported
+// variants (see the aliases at the end of this file).
+template <int Rows, int Cols, int WinLength>
+class BasicConnectFour : public Game {
 public:
-    ConnectFour();
+    using Board = BasicConnectFourBoard<Rows, Cols, WinLength>;
+    using Evaluator = BasicConnectFourEvaluator<Board>;
+    using MCTS = BasicConnectFourMCTS<Board>;
+    using Tablebase = BasicTablebase<Board>;
+
+    // AI search algorithm: iterative-deepening alpha-beta or Monte Carlo Tree Search
+    enum class Engine { AlphaBeta, MCTS };
+
+    // The exact solver and the opening book exist for the standard board only
+    static constexpr bool IS_STANDARD = std::is_same<Board, ConnectFourBoard>::value;
+
+    // AI thinking time per move in milliseconds, transposition table size in
+    // megabytes (kept for the whole game) and search threads (0 = one per core)
+    explicit BasicConnectFour(int timeBudgetMs = 100, size_t transpositionTableMB = 16, int threadCount = 0);
     void play() override;
-    std::string getName() const override { return "Connect Four"; }
-    virtual ~ConnectFour() = default;
+    std::string getName() const override;
+    virtual ~BasicConnectFour() { stopPondering(); }
+
+    // Switches the AI search; the MCTS node arena (megabytes) is allocated on first use
+    void setEngine(Engine e, size_t mctsArenaMB = 64);
+    Engine getEngine() const { return engine; }
+
+    // Keep searching on a background thread while the human picks a move
+    // (on by default). The time spent counts towards the AI's reply.
+    void setPondering(bool enabled) { pondering = enabled; }
+
+    // Stop alpha-beta's iterative deepening at this many plies (0 = time budget only)
+    void setMaxDepth(int plies) { depthLimit = plies; }
+
+    // Play perfectly (exact solver instead of heuristic search) once this
+    // many empty cells or fewer remain; 0 disables the solver
+    void setPerfectPlayThreshold(int emptyCells) { perfectPlayThreshold = emptyCells; }
+
+    // Opening book used for the first plies (default file: connectfour.book)
+    bool loadOpeningBook(const std::string& path) { return book.load(path); }
+    void setUseOpeningBook(bool enabled) { useBook = enabled; }
+
+    // Endgame tablebase, probed by the search and used for exact moves once
+    // the position is covered (default file: Tablebase::defaultPath())
+    bool loadTablebase(const std::string& path) { return tablebase.load(path); }
+
+    // --- Engine interface for non-interactive use ---
+    struct Analysis {
+        int col = -1;          // Best column, -1 if no legal move
+        int score = 0;         // From the side to move's point of view
+        int depth = 0;         // Completed search depth (plies to the end if solved)
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+        bool fromBook = false;
+        bool solved = false;
+    };
+
+    void newGame(); // Forget everything learned in the previous game
+    // Best move for `sideToMove` (Board::AI_SIDE / HUMAN_SIDE) in `position`
+    Analysis analyze(const Board& position, int sideToMove, int timeBudgetMs);
+
+    // Leaf count of the move tree `depth` plies below `position`, using the
+    // search's own move generation and win detection; a winning move ends
+    // its branch. `position` is restored on return.
+    static uint64_t perft(Board& position, int sideToMove, int depth);
 
 private:
     // Constants
-    static const int ROWS = 6;
-    static const int COLS = 7;
-    static const char HUMAN_PLAYER = 'X';
-    static const char AI_PLAYER = 'O';
-    static const char EMPTY_SLOT = '.';
-    static const int WIN_LENGTH = 4;
-    static const int MAX_DEPTH = 5; // Adjust AI difficulty (search depth)
+    static constexpr int ROWS = Board::ROWS;
+    static constexpr int COLS = Board::COLS;
+    static constexpr char HUMAN_PLAYER = 'X';
+    static constexpr char AI_PLAYER = 'O';
+    static constexpr char EMPTY_SLOT = '.';
+    static constexpr int WIN_LENGTH = Board::WIN_LENGTH;
+    static constexpr int ASPIRATION_WINDOW = 50; // Half-width of the window around the previous score
+    static constexpr int MAX_PLY = ROWS * COLS + 1;
+    static constexpr int MIN_REPLY_MS = 10; // Least time the AI searches after pondering
 
-    // Board
-    std::vector<std::vector<char>> board;
+    // Board (bitboard, see connectfourboard.h)
+    Board board;
+    int timeBudgetMs;           // Adjust AI difficulty (thinking time per move)
+    TranspositionTable transpositionTable; // Shared by all search threads, cleared each game
+    std::unique_ptr<ConnectFourSolver> solver; // Perfect play in the endgame (standard board only)
+    int perfectPlayThreshold = 24;         // Empty cells at which the solver takes over
+    OpeningBook book;
+    bool useBook = true;
+    Tablebase tablebase;                   // Small boards only; empty unless a table file exists
+    Engine engine = Engine::AlphaBeta;
+    int depthLimit = 0;
+    std::unique_ptr<MCTS> mcts;            // Created by setEngine(Engine::MCTS), trees kept across moves
+    bool pondering = true;
+    std::thread ponderThread;              // Runs during getPlayerMove(), joined by stopPondering()
+    std::chrono::steady_clock::time_point ponderStart;
 
     // Game Logic
     void initializeBoard();
@@ -42,10 +133,105 @@ private:
         int score = 0;
     };
 
-    Move findBestMove();
-    int minimaxAlphaBeta(int depth, int alpha, int beta, bool isMaximizingPlayer);
-    int evaluateBoard() const; // Heuristic function
-    int scoreLine(const std::vector<char>& line, char player) const; // Helper for evaluation
+    // Per-thread search state. Thread 0 drives iterative deepening and owns
+    // the result; helper threads (Lazy SMP) only feed the shared TT.
+    struct alignas(64) SearchThread { // Aligned to keep per-thread counters off shared cache lines
+        int id = 0;
+        int rootRotation = 0;       // Helpers rotate their root move order by this much
+        Board board;                // Private copy of the root position
+        Evaluator eval;             // Window counts kept in step with `board`
+        int searchDepth = 0;        // Plies searched by the current iteration
+        // Move ordering: killer moves per ply and history scores per (side, cell)
+        int killers[MAX_PLY][2];
+        int history[2][Board::BITS];
+        // Statistics for the current findBestMove() call
+        uint64_t nodes = 0;
+        uint64_t expandedNodes = 0;     // Nodes whose moves were searched
+        uint64_t betaCutoffs = 0;       // Expanded nodes that ended in a cutoff
+        uint64_t firstMoveCutoffs = 0;  // ... on the first move tried
+        uint64_t ttHits = 0;
+        uint64_t ttMisses = 0;
+        uint64_t tablebaseHits = 0;
+
+        // Drop/undo on both the board and the evaluator; play() returns the
+        // cell bit that undo() needs
+        int play(int col, int side) {
+            int bit = Board::bitIndex(board.moveBit(col));
+            board.play(col, side);
+            eval.add(bit, side);
+            return bit;
+        }
+        void undo(int col, int bit, int side) {
+            board.undo(col);
+            eval.remove(bit, side);
+        }
+    };
+
+    // Statistics of the last findBestMove() call, summed over threads
+    struct SearchStats {
+        int completedDepth = 0;
+        bool solved = false;        // Result came from the exact solver
+        bool fromTablebase = false; // Result came from the endgame tablebase
+        bool fromBook = false;      // Result came from the opening book
+        bool mcts = false;          // Result came from MCTS (nodes = playouts)
+        bool fromPonder = false;    // Alpha-beta result found while pondering
+        uint64_t nodes = 0;
+        uint64_t expandedNodes = 0;
+        uint64_t betaCutoffs = 0;
+        uint64_t firstMoveCutoffs = 0;
+        uint64_t ttHits = 0;
+        uint64_t ttMisses = 0;
+        uint64_t tablebaseHits = 0;
+        double seconds = 0.0;
+        // MCTS only
+        double winRate = 0.0;
+        uint64_t bestVisits = 0;
+        uint64_t reusedVisits = 0;
+        size_t treeNodes = 0;
+        double ponderSeconds = 0.0; // Background search during the human's turn
+    };
+
+    std::vector<SearchThread> searchThreads; // Kept across moves so history survives
+    std::atomic<bool> stopSearch{false};     // Set on deadline or when pondering ends; all threads unwind
+    std::chrono::steady_clock::time_point deadline;
+    SearchStats lastSearch;
+
+    // Alpha-beta pondering result: the AI's answer to one human reply
+    struct PonderResult {
+        Move move;
+        int depth = 0; // 0 if not searched
+    };
+    PonderResult ponderResults[COLS]; // Indexed by the human's reply column
+    PonderResult ponderHit;           // Entry for the reply actually played, used by the next search
+    std::mutex ponderMutex;           // Guards ponderResults while pondering
+
+    Move findBestMove(int timeBudgetMs);
+    Move searchAlphaBeta(int timeBudgetMs, const PonderResult& pondered);
+    Move searchMCTS(int timeBudgetMs);
+    void iterativeDeepening(SearchThread& t, Move& bestMove, int& completedDepth);
+    Move searchRoot(SearchThread& t, int depth, int alpha, int beta, int firstCol);
+    int minimaxAlphaBeta(SearchThread& t, int depth, int alpha, int beta, bool isMaximizingPlayer);
+    int orderMoves(const SearchThread& t, int ply, int side, int ttMove, int order[COLS]) const; // Returns move count
+    void recordCutoff(SearchThread& t, int ply, int side, int col, int remaining, int moveIndex);
+    static void resetMoveOrdering(SearchThread& t);
+    void displaySearchStats() const;
+
+    // Pondering: background search of the position with the human to move
+    void startPondering();
+    int stopPondering(); // Returns milliseconds pondered (0 if not pondering)
+    void ponderAlphaBeta();
+    static int sideOf(char player) { return player == AI_PLAYER ? Board::AI_SIDE : Board::HUMAN_SIDE; }
 };
 
+// --- Supported geometries (explicitly instantiated in connectfour.cpp) ---
+using ConnectFour = BasicConnectFour<6, 7, 4>;        // Classic 7 columns x 6 rows
+using ConnectFour8x7 = BasicConnectFour<7, 8, 4>;     // 8 columns x 7 rows, still one 64-bit word
+#if defined(__SIZEOF_INT128__)
+using ConnectFour9x7 = BasicConnectFour<7, 9, 4>;     // 9 columns x 7 rows, 72 bits: 128-bit masks
+#endif
+using ConnectFive = BasicConnectFour<6, 9, 5>;        // Five in a row on 9 columns x 6 rows
+using ConnectFour5x4 = BasicConnectFour<4, 5, 4>;     // 5 columns x 4 rows, small enough for a tablebase
+using ConnectFour5x5 = BasicConnectFour<5, 5, 4>;     // 5 columns x 5 rows, tablebase of about 660 MB
+// --- End supported geometries ---
+
 #endif // CONNECTFOUR_H
\ No newline at end of file
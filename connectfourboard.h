@@ -0,0 +1,252 @@
+#ifndef CONNECTFOURBOARD_H
+#define CONNECTFOURBOARD_H
+
+#include <cstdint>
+#include <type_traits>
+
+// --- Bit helpers ---
+// Boards of up to 64 bits (sentinels included) use uint64_t masks; larger
+// geometries use a 128-bit integer where the compiler provides one.
+namespace c4bits {
+#if defined(__SIZEOF_INT128__)
+    using uint128 = unsigned __int128;
+#else
+    using uint128 = void; // No geometry above 64 bits on this compiler
+#endif
+
+    inline int popcount(uint64_t m) {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(m);
+    #else
+        int n = 0;
+        for (; m; m &= m - 1) ++n;
+        return n;
+    #endif
+    }
+
+    // Index of the lowest set bit (m != 0)
+    inline int lowestBit(uint64_t m) {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(m);
+    #else
+        int i = 0;
+        while (!(m & 1)) { m >>= 1; ++i; }
+        return i;
+    #endif
+    }
+
+#if defined(__SIZEOF_INT128__)
+    inline int popcount(uint128 m) {
+        return popcount(static_cast<uint64_t>(m)) + popcount(static_cast<uint64_t>(m >> 64));
+    }
+    inline int lowestBit(uint128 m) {
+        uint64_t low = static_cast<uint64_t>(m);
+        return low ? lowestBit(low) : 64 + lowestBit(static_cast<uint64_t>(m >> 64));
+    }
+#endif
+}
+// --- End bit helpers ---
+
+// --- Zobrist keys ---
+// One random 64-bit key per (side, bit) pair, generated at compile time with
+// splitmix64 so the hash is identical on every build and platform.
+namespace zobrist {
+    const int MAX_BITS = 128;
+
+    constexpr uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    struct Keys {
+        uint64_t piece[2][MAX_BITS] = {};
+        uint64_t sideToMove = 0;
+    };
+
+    constexpr Keys makeKeys() {
+        Keys keys;
+        uint64_t state = 0x436F6E6E65637434ULL; // Fixed seed
+        for (int side = 0; side < 2; ++side)
+            for (int bit = 0; bit < 64; ++bit)
+                keys.piece[side][bit] = splitmix64(state);
+        keys.sideToMove = splitmix64(state);
+        // Keys for bits 64+ are drawn afterwards so 64-bit boards hash as before
+        for (int side = 0; side < 2; ++side)
+            for (int bit = 64; bit < MAX_BITS; ++bit)
+                keys.piece[side][bit] = splitmix64(state);
+        return keys;
+    }
+
+    inline constexpr Keys KEYS = makeKeys();
+}
+// --- End Zobrist keys ---
+
+// Bitboard position for Connect Four on a Rows x Cols board, WinLength in a row.
+//
+// Each column uses ROWS + 1 bits (one sentinel bit on top), so the classic
+// 6x7 board fits into a single 64-bit word. Bit (col * H1 + row) is the cell
+// at `row` counted from the bottom. One mask per side holds that side's
+// pieces, `mask` holds every occupied cell. A Zobrist hash of the position
+// is kept up to date by play() and undo().
+//
+// The geometry is a template parameter, so every mask and shift below is a
+// compile-time constant and each board size gets its own specialized code.
+template <int Rows, int Cols, int WinLength>
+class BasicConnectFourBoard {
+public:
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+    static constexpr int WIN_LENGTH = WinLength;
+    static constexpr int H1 = ROWS + 1; // Bits per column including the sentinel
+    static constexpr int BITS = H1 * COLS;
+
+    using Bits = std::conditional_t<(BITS <= 64), uint64_t, c4bits::uint128>;
+    static_assert(!std::is_void<Bits>::value, "This board needs 128-bit integers, which this compiler lacks");
+    static_assert(BITS <= zobrist::MAX_BITS, "Board too large for the Zobrist key table");
+    static_assert(WIN_LENGTH >= 2 && WIN_LENGTH <= ROWS && WIN_LENGTH <= COLS, "Win length must fit on the board");
+
+    // Side indices used for the per-player masks
+    static constexpr int AI_SIDE = 0;
+    static constexpr int HUMAN_SIDE = 1;
+
+    BasicConnectFourBoard() { reset(); }
+
+    void reset() {
+        pieces[0] = pieces[1] = 0;
+        mask = 0;
+        moves = 0;
+        hashKey = 0;
+    }
+
+    // Loads an arbitrary position from per-side masks (hash is recomputed)
+    void setPosition(Bits aiMask, Bits humanMask) {
+        reset();
+        pieces[AI_SIDE] = aiMask;
+        pieces[HUMAN_SIDE] = humanMask;
+        mask = aiMask | humanMask;
+        moves = popcount(mask);
+        for (int side = 0; side < 2; ++side) {
+            for (Bits m = pieces[side]; m; m &= m - 1) hashKey ^= zobrist::KEYS.piece[side][bitIndex(m)];
+        }
+    }
+
+    // Same position with the two sides' stones exchanged
+    BasicConnectFourBoard swapped() const {
+        BasicConnectFourBoard b;
+        b.setPosition(pieces[HUMAN_SIDE], pieces[AI_SIDE]);
+        return b;
+    }
+
+    // Left/right mirror image of a mask (column c becomes COLS - 1 - c)
+    static Bits mirror(Bits m) {
+        Bits r = 0;
+        for (int c = 0; c < COLS; ++c) {
+            r |= ((m >> (c * H1)) & ((Bits(1) << H1) - 1)) << ((COLS - 1 - c) * H1);
+        }
+        return r;
+    }
+
+    // --- Column masks ---
+    static constexpr Bits bottomMask(int col) { return Bits(1) << (col * H1); }
+    static constexpr Bits topMask(int col) { return Bits(1) << (ROWS - 1 + col * H1); }
+    static constexpr Bits columnMask(int col) { return ((Bits(1) << ROWS) - 1) << (col * H1); }
+    static constexpr Bits cellMask(int row, int col) { return Bits(1) << (col * H1 + row); }
+
+    // --- Move generation (all O(1)) ---
+    bool canPlay(int col) const { return (mask & topMask(col)) == 0; }
+
+    // Bit of the next free cell in a column (0 if the column is full)
+    Bits moveBit(int col) const { return (mask + bottomMask(col)) & columnMask(col); }
+
+    void play(int col, int side) {
+        Bits m = moveBit(col);
+        pieces[side] |= m;
+        mask |= m;
+        hashKey ^= zobrist::KEYS.piece[side][bitIndex(m)];
+        ++moves;
+    }
+
+    // Removes the top piece of a column. Column bits are contiguous from the
+    // bottom, so adding the bottom bit and shifting right lands on the top piece.
+    void undo(int col) {
+        Bits m = ((mask & columnMask(col)) + bottomMask(col)) >> 1;
+        hashKey ^= zobrist::KEYS.piece[(pieces[AI_SIDE] & m) ? AI_SIDE : HUMAN_SIDE][bitIndex(m)];
+        pieces[0] &= ~m;
+        pieces[1] &= ~m;
+        mask &= ~m;
+        --moves;
+    }
+
+    // True if dropping `side` into `col` completes a line
+    bool isWinningMove(int col, int side) const {
+        return alignment(pieces[side] | moveBit(col));
+    }
+
+    bool hasWon(int side) const { return alignment(pieces[side]); }
+    bool isFull() const { return moves == ROWS * COLS; }
+    int moveCount() const { return moves; }
+
+    Bits sideMask(int side) const { return pieces[side]; }
+    Bits occupiedMask() const { return mask; }
+
+    // Zobrist hash of the pieces; callers fold in the side to move
+    uint64_t hash() const { return hashKey; }
+    uint64_t hash(int sideToMove) const { return sideToMove == AI_SIDE ? hashKey ^ zobrist::KEYS.sideToMove : hashKey; }
+
+    // Row (from the bottom) the next piece in `col` would land on, -1 if full
+    int nextOpenRow(int col) const {
+        for (int r = 0; r < ROWS; ++r) {
+            if (!(mask & cellMask(r, col))) return r;
+        }
+        return -1;
+    }
+
+    // Side occupying a cell (row counted from the bottom), -1 if empty
+    int cellOwner(int row, int col) const {
+        Bits m = cellMask(row, col);
+        if (pieces[AI_SIDE] & m) return AI_SIDE;
+        if (pieces[HUMAN_SIDE] & m) return HUMAN_SIDE;
+        return -1;
+    }
+
+    // WIN_LENGTH-in-a-row test by shift-and-AND in each direction
+    static bool alignment(Bits pos) {
+        return runs(pos, H1)        // Horizontal
+            || runs(pos, H1 + 1)    // Diagonal (/)
+            || runs(pos, H1 - 1)    // Diagonal (\)
+            || runs(pos, 1);        // Vertical
+    }
+
+    static int popcount(Bits m) { return c4bits::popcount(m); }
+
+    // Index of the lowest set bit in m
+    static int bitIndex(Bits m) { return c4bits::lowestBit(m); }
+
+private:
+    Bits pieces[2];
+    Bits mask;
+    int moves;
+    uint64_t hashKey;
+
+    // Nonzero if `pos` holds WIN_LENGTH stones `step` bits apart. Each AND
+    // doubles the run length (1, 2, 4...); a last overlapping AND tops it up
+    // to WIN_LENGTH. The loop unrolls at compile time, so four in a row is
+    // the same two shifts as before. Sentinel bits stop runs wrapping columns.
+    static bool runs(Bits pos, int step) {
+        Bits m = pos;
+        int len = 1;
+        while (len * 2 <= WIN_LENGTH) {
+            m &= m >> (len * step);
+            len *= 2;
+        }
+        if (len < WIN_LENGTH) m &= m >> ((WIN_LENGTH - len) * step);
+        return m != 0;
+    }
+};
+
+// The classic 7 columns x 6 rows, four in a row
+using ConnectFourBoard = BasicConnectFourBoard<6, 7, 4>;
+
+#endif // CONNECTFOURBOARD_H
@@ -0,0 +1,140 @@
+#ifndef CONNECTFOUREVALUATOR_H
+#define CONNECTFOUREVALUATOR_H
+
+#include "connectfourboard.h"
+#include <cstdint>
+
+// Incremental version of the ConnectFour window heuristic.
+//
+// The board has a fixed set of winning windows (every WIN_LENGTH-cell line,
+// 69 on 6x7). The evaluator keeps each side's piece count per window and the
+// running score, and updates both when a piece is added or removed. Only the
+// windows through that cell are touched (at most 4 * WIN_LENGTH), so the leaf
+// score is read in O(1). The window tables are built at compile time once
+// per board geometry.
+namespace c4eval {
+    // Directions as (dRow, dCol): horizontal, vertical, both diagonals
+    constexpr int DIRS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {-1, 1}};
+
+    template <class Board>
+    constexpr bool onBoard(int r, int c) {
+        return r >= 0 && r < Board::ROWS && c >= 0 && c < Board::COLS;
+    }
+
+    template <class Board>
+    constexpr int countWindows() {
+        int n = 0;
+        for (const auto& d : DIRS)
+            for (int r = 0; r < Board::ROWS; ++r)
+                for (int c = 0; c < Board::COLS; ++c)
+                    if (onBoard<Board>(r + (Board::WIN_LENGTH - 1) * d[0], c + (Board::WIN_LENGTH - 1) * d[1])) ++n;
+        return n;
+    }
+
+    template <class Board>
+    struct Tables {
+        static constexpr int NUM_WINDOWS = countWindows<Board>();
+        static constexpr int MAX_WINDOWS_PER_CELL = 4 * Board::WIN_LENGTH;
+
+        typename Board::Bits windows[NUM_WINDOWS] = {};
+        uint8_t cellWindowCount[Board::BITS] = {};
+        uint8_t cellWindows[Board::BITS][MAX_WINDOWS_PER_CELL] = {};
+        int contribution[Board::WIN_LENGTH + 1][Board::WIN_LENGTH + 1] = {}; // [ai][human]
+    };
+
+    // Score of one window for `player`, zero if the opponent has a piece in it.
+    // Scores depend on how many stones are still missing, so longer win
+    // lengths rate their near-complete lines like four in a row does.
+    template <int WinLength>
+    constexpr int lineScore(int playerCount, int opponentCount) {
+        if (opponentCount > 0 || playerCount == 0) return 0;
+        int missing = WinLength - playerCount;
+        return missing == 0 ? 10000  // Win
+             : missing == 1 ? 100    // Threaten win
+             : missing == 2 ? 10     // Potential
+             : missing == 3 ? 1      // Slight potential
+             : 0;
+    }
+
+    template <class Board>
+    constexpr Tables<Board> makeTables() {
+        using Bits = typename Board::Bits;
+        Tables<Board> t;
+        int w = 0;
+        for (const auto& d : DIRS) {
+            for (int r = 0; r < Board::ROWS; ++r) {
+                for (int c = 0; c < Board::COLS; ++c) {
+                    if (!onBoard<Board>(r + (Board::WIN_LENGTH - 1) * d[0], c + (Board::WIN_LENGTH - 1) * d[1])) continue;
+                    for (int k = 0; k < Board::WIN_LENGTH; ++k) {
+                        int bit = (c + k * d[1]) * Board::H1 + (r + k * d[0]);
+                        t.windows[w] |= Bits(1) << bit;
+                        t.cellWindows[bit][t.cellWindowCount[bit]++] = static_cast<uint8_t>(w);
+                    }
+                    ++w;
+                }
+            }
+        }
+        for (int a = 0; a <= Board::WIN_LENGTH; ++a)
+            for (int h = 0; h <= Board::WIN_LENGTH; ++h)
+                t.contribution[a][h] = lineScore<Board::WIN_LENGTH>(a, h) - lineScore<Board::WIN_LENGTH>(h, a);
+        return t;
+    }
+
+    template <class Board>
+    inline constexpr Tables<Board> TABLES = makeTables<Board>();
+
+    const int CENTER_WEIGHT = 3; // Per piece in the center column
+}
+
+template <class Board>
+class BasicConnectFourEvaluator {
+public:
+    static constexpr int NUM_WINDOWS = c4eval::Tables<Board>::NUM_WINDOWS;
+    static_assert(NUM_WINDOWS <= 256, "Window indices are stored as uint8_t");
+
+    BasicConnectFourEvaluator() { clear(); }
+
+    void clear() {
+        for (auto& side : counts) for (uint8_t& n : side) n = 0;
+        total = 0;
+    }
+
+    // Rebuilds counts and score from scratch for an arbitrary position
+    void reset(const Board& board) {
+        clear();
+        for (int bit = 0; bit < Board::BITS; ++bit) {
+            typename Board::Bits m = typename Board::Bits(1) << bit;
+            if (board.sideMask(Board::AI_SIDE) & m) add(bit, Board::AI_SIDE);
+            else if (board.sideMask(Board::HUMAN_SIDE) & m) add(bit, Board::HUMAN_SIDE);
+        }
+    }
+
+    void add(int bit, int side) { update(bit, side, +1); }
+    void remove(int bit, int side) { update(bit, side, -1); }
+
+    // Heuristic score from the AI's point of view
+    int score() const { return total; }
+
+private:
+    uint8_t counts[2][NUM_WINDOWS];
+    int total;
+
+    void update(int bit, int side, int delta) {
+        const c4eval::Tables<Board>& t = c4eval::TABLES<Board>;
+        for (int i = 0; i < t.cellWindowCount[bit]; ++i) {
+            int w = t.cellWindows[bit][i];
+            uint8_t& ai = counts[Board::AI_SIDE][w];
+            uint8_t& human = counts[Board::HUMAN_SIDE][w];
+            total -= t.contribution[ai][human];
+            counts[side][w] = static_cast<uint8_t>(counts[side][w] + delta);
+            total += t.contribution[ai][human];
+        }
+        if (bit / Board::H1 == Board::COLS / 2) {
+            total += (side == Board::AI_SIDE ? delta : -delta) * c4eval::CENTER_WEIGHT;
+        }
+    }
+};
+
+using ConnectFourEvaluator = BasicConnectFourEvaluator<ConnectFourBoard>;
+
+#endif // CONNECTFOUREVALUATOR_H
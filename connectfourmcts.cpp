@@ -0,0 +1,305 @@
+#include "connectfourmcts.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+
+template <class Board>
+BasicConnectFourMCTS<Board>::BasicConnectFourMCTS(size_t arenaMB, int threadCount) {
+    if (threadCount <= 0) threadCount = max(1, static_cast<int>(thread::hardware_concurrency()));
+    workers.resize(threadCount);
+    size_t perThread = max<size_t>(arenaMB, 1) * 1024 * 1024 / threadCount / sizeof(Node);
+    uint32_t capacity = static_cast<uint32_t>(min<size_t>(perThread, NONE - 1));
+    random_device seed;
+    for (Worker& w : workers) {
+        w.arena.nodes.reset(new Node[capacity]);
+        w.arena.capacity = capacity;
+        w.rng.seed(seed());
+    }
+}
+
+template <class Board>
+void BasicConnectFourMCTS<Board>::reset() {
+    for (Worker& w : workers) {
+        w.arena.used = 0;
+        w.root = NONE;
+    }
+}
+
+// --- Search driver ---
+template <class Board>
+auto BasicConnectFourMCTS<Board>::search(const Board& position, int sideToMove, int timeBudgetMs,
+                                         const atomic<bool>* stop) -> Result {
+    Result result;
+    bool anyMove = false;
+    for (int c = 0; c < Board::COLS; ++c) anyMove = anyMove || position.canPlay(c);
+    if (!anyMove || position.hasWon(Board::AI_SIDE) || position.hasWon(Board::HUMAN_SIDE)) return result;
+
+    auto start = chrono::steady_clock::now();
+    auto deadline = start + chrono::milliseconds(timeBudgetMs);
+    for (Worker& w : workers) {
+        prepareRoot(w, position, sideToMove);
+        result.reusedVisits += w.arena.nodes[w.root].visits;
+        w.playouts = 0;
+        w.maxDepth = 0;
+    }
+
+    vector<thread> helpers;
+    for (size_t i = 1; i < workers.size(); ++i) {
+        helpers.emplace_back([this, i, deadline, stop] { runWorker(workers[i], deadline, stop); });
+    }
+    runWorker(workers[0], deadline, stop);
+    for (thread& h : helpers) h.join();
+
+    // Root parallelism: sum each root move's statistics over all trees
+    uint64_t visits[Board::COLS] = {};
+    uint64_t score[Board::COLS] = {};
+    for (const Worker& w : workers) {
+        const Node& root = w.arena.nodes[w.root];
+        for (uint32_t i = 0; i < root.childCount; ++i) {
+            const Node& child = w.arena.nodes[root.firstChild + i];
+            visits[child.move] += child.visits;
+            score[child.move] += child.score;
+        }
+        result.playouts += w.playouts;
+        result.treeNodes += w.arena.used;
+        result.maxDepth = max(result.maxDepth, w.maxDepth);
+    }
+    for (int c = 0; c < Board::COLS; ++c) {
+        if (visits[c] == 0) continue;
+        if (result.col == -1 || visits[c] > visits[result.col] ||
+            (visits[c] == visits[result.col] && score[c] > score[result.col])) {
+            result.col = c;
+        }
+    }
+    if (result.col != -1) {
+        result.bestVisits = visits[result.col];
+        result.winRate = score[result.col] / (2.0 * visits[result.col]);
+    }
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+template <class Board>
+void BasicConnectFourMCTS<Board>::runWorker(Worker& w, chrono::steady_clock::time_point deadline,
+                                            const atomic<bool>* stop) {
+    // Always run at least one batch so every tree has root statistics
+    do {
+        for (int i = 0; i < 256; ++i) iterate(w);
+    } while (chrono::steady_clock::now() < deadline && !(stop && stop->load(memory_order_relaxed)));
+}
+// --- End search driver ---
+
+// --- Tree reuse ---
+// Keeps the subtree of the previous search that matches `position`, or
+// starts a fresh tree. Nodes of discarded branches stay allocated until the
+// arena is over half full, at which point the kept subtree is compacted.
+template <class Board>
+void BasicConnectFourMCTS<Board>::prepareRoot(Worker& w, const Board& position, int sideToMove) {
+    if (!advanceRoot(w, position, sideToMove)) {
+        w.arena.used = 0;
+        w.root = newRoot(w, position, sideToMove);
+    } else if (w.arena.used > w.arena.capacity / 2) {
+        compact(w);
+    }
+}
+
+// Copies the tree under the root to the front of the arena in breadth-first
+// order (children blocks stay contiguous) and frees everything else
+template <class Board>
+void BasicConnectFourMCTS<Board>::compact(Worker& w) {
+    const Node* nodes = w.arena.nodes.get();
+    vector<Node> kept;
+    kept.push_back(nodes[w.root]);
+    for (size_t i = 0; i < kept.size(); ++i) {
+        uint32_t oldFirst = kept[i].firstChild;
+        if (oldFirst == NONE) continue;
+        kept[i].firstChild = static_cast<uint32_t>(kept.size());
+        for (uint32_t c = 0; c < kept[i].childCount; ++c) kept.push_back(nodes[oldFirst + c]);
+    }
+    copy(kept.begin(), kept.end(), w.arena.nodes.get());
+    w.arena.used = static_cast<uint32_t>(kept.size());
+    w.root = 0;
+}
+
+// Walks the root down the moves that turn the old root position into
+// `position`. Stones only ever get added, so at each step the child whose
+// move puts a stone where `position` has one of the mover's stones is taken.
+template <class Board>
+bool BasicConnectFourMCTS<Board>::advanceRoot(Worker& w, const Board& position, int sideToMove) {
+    if (w.root == NONE) return false;
+    for (int s = 0; s < 2; ++s) {
+        if (w.rootBoard.sideMask(s) & ~position.sideMask(s)) return false;
+    }
+    const Node* nodes = w.arena.nodes.get();
+    Board board = w.rootBoard;
+    int side = w.rootSide;
+    uint32_t node = w.root;
+    while (board.moveCount() < position.moveCount()) {
+        const Node& n = nodes[node];
+        if (n.firstChild == NONE) return false;
+        uint32_t next = NONE;
+        for (uint32_t i = 0; i < n.childCount && next == NONE; ++i) {
+            if (position.sideMask(side) & board.moveBit(nodes[n.firstChild + i].move)) next = n.firstChild + i;
+        }
+        if (next == NONE) return false;
+        board.play(nodes[next].move, side);
+        side = 1 - side;
+        node = next;
+    }
+    if (side != sideToMove || nodes[node].terminal != ONGOING ||
+        board.sideMask(0) != position.sideMask(0) || board.sideMask(1) != position.sideMask(1)) {
+        return false;
+    }
+    w.root = node;
+    w.rootBoard = position;
+    w.rootSide = sideToMove;
+    return true;
+}
+
+template <class Board>
+uint32_t BasicConnectFourMCTS<Board>::newRoot(Worker& w, const Board& position, int sideToMove) {
+    uint32_t root = w.arena.allocate(1);
+    Node& n = w.arena.nodes[root];
+    n.firstChild = NONE;
+    n.visits = 0;
+    n.score = 0;
+    n.move = -1;
+    n.childCount = 0;
+    n.terminal = ONGOING;
+    n.unused = 0;
+    w.rootBoard = position;
+    w.rootSide = sideToMove;
+    return root;
+}
+// --- End tree reuse ---
+
+// --- One MCTS iteration: select, expand, playout, backpropagate ---
+template <class Board>
+void BasicConnectFourMCTS<Board>::iterate(Worker& w) {
+    Node* nodes = w.arena.nodes.get();
+    Board board = w.rootBoard;
+    int side = w.rootSide;
+    uint32_t path[Board::ROWS * Board::COLS + 1];
+    int len = 0;
+    uint32_t node = w.root;
+    path[len++] = node;
+
+    // Selection: descend through expanded nodes by UCT
+    while (nodes[node].firstChild != NONE && nodes[node].terminal == ONGOING) {
+        node = select(w, node);
+        board.play(nodes[node].move, side);
+        side = 1 - side;
+        path[len++] = node;
+    }
+
+    // Expansion: a leaf is expanded on its second visit (the root at once),
+    // which keeps the tree at about one node per playout
+    if (nodes[node].terminal == ONGOING && (nodes[node].visits > 0 || node == w.root) &&
+        expand(w, node, board, side)) {
+        node = select(w, node);
+        board.play(nodes[node].move, side);
+        side = 1 - side;
+        path[len++] = node;
+    }
+
+    int winner;
+    if (nodes[node].terminal == MOVER_WINS) winner = 1 - side;
+    else if (nodes[node].terminal == DRAW) winner = -1;
+    else winner = playout(w, board, side);
+    ++w.playouts;
+    w.maxDepth = max(w.maxDepth, len - 1);
+
+    // Backpropagation: the side that moved into path[i] alternates with depth
+    for (int i = 0; i < len; ++i) {
+        Node& n = nodes[path[i]];
+        int mover = (i % 2 == 1) ? w.rootSide : 1 - w.rootSide;
+        ++n.visits;
+        n.score += winner == -1 ? 1 : winner == mover ? 2 : 0;
+    }
+}
+
+// Allocates all children of `node` as one block; false if the arena is full
+template <class Board>
+bool BasicConnectFourMCTS<Board>::expand(Worker& w, uint32_t node, const Board& board, int side) {
+    int cols[Board::COLS];
+    int count = 0;
+    for (int c = 0; c < Board::COLS; ++c) {
+        if (board.canPlay(c)) cols[count++] = c;
+    }
+    if (count == 0) return false;
+    uint32_t first = w.arena.allocate(count);
+    if (first == NONE) return false;
+
+    for (int i = 0; i < count; ++i) {
+        Node& child = w.arena.nodes[first + i];
+        child.firstChild = NONE;
+        child.visits = 0;
+        child.score = 0;
+        child.move = static_cast<int8_t>(cols[i]);
+        child.childCount = 0;
+        child.terminal = board.isWinningMove(cols[i], side) ? MOVER_WINS
+                       : board.moveCount() + 1 == Board::ROWS * Board::COLS ? DRAW : ONGOING;
+        child.unused = 0;
+    }
+    Node& parent = w.arena.nodes[node];
+    parent.firstChild = first;
+    parent.childCount = static_cast<uint8_t>(count);
+    return true;
+}
+
+// UCT: unvisited children first, a winning move always, otherwise the
+// highest mean result plus exploration bonus
+template <class Board>
+uint32_t BasicConnectFourMCTS<Board>::select(const Worker& w, uint32_t node) const {
+    const Node* nodes = w.arena.nodes.get();
+    const Node& parent = nodes[node];
+    double logVisits = log(static_cast<double>(max<uint32_t>(parent.visits, 1)));
+    uint32_t best = parent.firstChild;
+    double bestValue = -1.0;
+    for (uint32_t i = 0; i < parent.childCount; ++i) {
+        uint32_t idx = parent.firstChild + i;
+        const Node& child = nodes[idx];
+        if (child.visits == 0 || child.terminal == MOVER_WINS) return idx;
+        double value = child.score / (2.0 * child.visits) + EXPLORATION * sqrt(logVisits / child.visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = idx;
+        }
+    }
+    return best;
+}
+
+// Lightly biased random playout: win if possible, else block the
+// opponent's immediate win, else a uniformly random column
+template <class Board>
+int BasicConnectFourMCTS<Board>::playout(Worker& w, Board& board, int side) {
+    while (!board.isFull()) {
+        int cols[Board::COLS];
+        int count = 0;
+        int block = -1;
+        for (int c = 0; c < Board::COLS; ++c) {
+            if (!board.canPlay(c)) continue;
+            if (board.isWinningMove(c, side)) return side;
+            if (block == -1 && board.isWinningMove(c, 1 - side)) block = c;
+            cols[count++] = c;
+        }
+        int col = block != -1 ? block : cols[w.rng() % count];
+        board.play(col, side);
+        side = 1 - side;
+    }
+    return -1;
+}
+// --- End MCTS iteration ---
+
+// --- Explicit instantiations (one per ConnectFour geometry, see connectfour.h) ---
+template class BasicConnectFourMCTS<BasicConnectFourBoard<6, 7, 4>>;
+template class BasicConnectFourMCTS<BasicConnectFourBoard<7, 8, 4>>;
+#if defined(__SIZEOF_INT128__)
+template class BasicConnectFourMCTS<BasicConnectFourBoard<7, 9, 4>>;
+#endif
+template class BasicConnectFourMCTS<BasicConnectFourBoard<6, 9, 5>>;
+template class BasicConnectFourMCTS<BasicConnectFourBoard<4, 5, 4>>;
+template class BasicConnectFourMCTS<BasicConnectFourBoard<5, 5, 4>>;
+// --- End explicit instantiations ---
@@ -0,0 +1,112 @@
+#ifndef CONNECTFOURMCTS_H
+#define CONNECTFOURMCTS_H
+
+#include "connectfourboard.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Monte Carlo Tree Search for Connect Four (any board geometry).
+//
+// UCT selection, expansion of all children at once, lightly biased random
+// playouts (take an immediate win, otherwise block one, otherwise random)
+// and win/draw/loss backpropagation.
+//
+// Search is root-parallel: every thread grows its own tree from the same root
+// and the root statistics are summed at the end, so threads never share a
+// node. Each thread allocates its nodes from its own contiguous arena; a
+// node's children are one block, so a tree is a few index links and no heap
+// allocations. Trees are kept between moves: the next search walks the root
+// down the moves played since and keeps that subtree, compacted to the front
+// of the arena once it is over half full. Resetting for a new game only
+// rewinds the arenas.
+template <class Board>
+class BasicConnectFourMCTS {
+public:
+    struct Result {
+        int col = -1;             // Most visited root move, -1 if no legal move
+        double winRate = 0.0;     // Its mean result for the side to move (draw = 0.5)
+        uint64_t playouts = 0;    // Playouts run by this search, all threads
+        uint64_t bestVisits = 0;  // Visits of the chosen move, all threads
+        uint64_t reusedVisits = 0; // Root visits inherited from the previous search
+        size_t treeNodes = 0;     // Nodes in use after the search, all threads
+        int maxDepth = 0;         // Deepest selection path
+        double seconds = 0.0;
+    };
+
+    // Node memory in megabytes (shared out among the threads) and threads (0 = one per core)
+    explicit BasicConnectFourMCTS(size_t arenaMB = 64, int threadCount = 0);
+
+    // Best move for `sideToMove` (Board::AI_SIDE / HUMAN_SIDE) in `position`.
+    // Runs until the time budget is used up or `stop` becomes true.
+    Result search(const Board& position, int sideToMove, int timeBudgetMs, const std::atomic<bool>* stop = nullptr);
+
+    void reset(); // Drops every tree in O(1)
+
+    int threadCount() const { return static_cast<int>(workers.size()); }
+    static constexpr size_t bytesPerNode() { return sizeof(Node); }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // Result of the game at a node, fixed once the move into it ends the game
+    enum Terminal : uint8_t { ONGOING = 0, MOVER_WINS = 1, DRAW = 2 };
+
+    // 16 bytes; `score` and `terminal` are from the view of the side that
+    // made `move` (the parent picks the child that is best for itself)
+    struct Node {
+        uint32_t firstChild; // Arena index of the first child, NONE until expanded
+        uint32_t visits;
+        uint32_t score;      // Sum of results in half points: win 2, draw 1, loss 0
+        int8_t move;         // Column played to reach this node
+        uint8_t childCount;
+        uint8_t terminal;
+        uint8_t unused;
+    };
+
+    // Bump allocator over one contiguous block of nodes
+    struct Arena {
+        std::unique_ptr<Node[]> nodes; // Default-initialized: nothing is touched until allocated
+        uint32_t capacity = 0;
+        uint32_t used = 0;
+
+        uint32_t allocate(uint32_t count) {
+            if (capacity - used < count) return NONE;
+            uint32_t first = used;
+            used += count;
+            return first;
+        }
+    };
+
+    struct alignas(64) Worker {
+        Arena arena;
+        uint32_t root = NONE;
+        Board rootBoard;
+        int rootSide = Board::AI_SIDE;
+        std::mt19937 rng;
+        uint64_t playouts = 0;
+        int maxDepth = 0;
+    };
+
+    std::vector<Worker> workers;
+
+    static constexpr double EXPLORATION = 1.4; // UCT exploration constant
+
+    void prepareRoot(Worker& w, const Board& position, int sideToMove);
+    bool advanceRoot(Worker& w, const Board& position, int sideToMove);
+    uint32_t newRoot(Worker& w, const Board& position, int sideToMove);
+    static void compact(Worker& w);
+    void runWorker(Worker& w, std::chrono::steady_clock::time_point deadline, const std::atomic<bool>* stop);
+    void iterate(Worker& w);
+    bool expand(Worker& w, uint32_t node, const Board& board, int side);
+    uint32_t select(const Worker& w, uint32_t node) const;
+    static int playout(Worker& w, Board& board, int side); // Winner side, -1 for a draw
+};
+
+using ConnectFourMCTS = BasicConnectFourMCTS<ConnectFourBoard>;
+
+#endif // CONNECTFOURMCTS_H
@@ -0,0 +1,257 @@
+#include "connectfoursolver.h"
+#include <chrono>
+#include <bitset>
+
+using namespace std;
+
+namespace {
+    const int CELLS = ConnectFourBoard::ROWS * ConnectFourBoard::COLS;
+    const int H = ConnectFourBoard::ROWS;
+    const int H1 = ConnectFourBoard::H1;
+    const int CENTER_OUT[ConnectFourBoard::COLS] = {3, 2, 4, 1, 5, 0, 6};
+
+    constexpr uint64_t bottomRow() {
+        uint64_t m = 0;
+        for (int c = 0; c < ConnectFourBoard::COLS; ++c) m |= ConnectFourBoard::bottomMask(c);
+        return m;
+    }
+    const uint64_t BOTTOM = bottomRow();
+    const uint64_t BOARD = BOTTOM * ((uint64_t(1) << H) - 1); // Every playable cell
+
+    inline int popcount(uint64_t x) { return static_cast<int>(bitset<64>(x).count()); }
+
+    // The position key is unique but clusters in its low bits; an odd
+    // multiplier spreads it over the table without losing uniqueness
+    inline uint64_t tableKey(uint64_t key) { return key * 0x9E3779B97F4A7C15ULL; }
+}
+
+ConnectFourSolver::ConnectFourSolver(size_t transpositionTableMB) : table(transpositionTableMB) {}
+
+void ConnectFourSolver::reset() {
+    table.clear();
+}
+
+// --- Position helpers ---
+uint64_t ConnectFourSolver::Position::possible() const {
+    return (mask + BOTTOM) & BOARD;
+}
+
+uint64_t ConnectFourSolver::Position::winningPositions() const {
+    return winningCells(current, mask);
+}
+
+uint64_t ConnectFourSolver::Position::opponentWinningPositions() const {
+    return winningCells(current ^ mask, mask);
+}
+
+// Playable moves that do not let the opponent win on their next move. If the
+// opponent has two immediate threats there is no such move and this is 0.
+uint64_t ConnectFourSolver::Position::nonLosingMoves() const {
+    uint64_t moves = possible();
+    uint64_t opponentWin = opponentWinningPositions();
+    uint64_t forced = moves & opponentWin;
+    if (forced) {
+        if (forced & (forced - 1)) return 0; // Two threats at once, cannot block both
+        moves = forced;                      // Must block the only threat
+    }
+    return moves & ~(opponentWin >> 1);      // Never play right under an opponent threat
+}
+
+// Number of winning cells the side to move would have after `move`
+int ConnectFourSolver::Position::moveScore(uint64_t move) const {
+    return popcount(winningCells(current | move, mask));
+}
+
+// Empty cells that would complete a line of `position`
+uint64_t ConnectFourSolver::winningCells(uint64_t position, uint64_t mask) {
+    // Vertical
+    uint64_t r = (position << 1) & (position << 2) & (position << 3);
+
+    // Horizontal and both diagonals: shift by H1 (horizontal), H (\) and H + 2 (/)
+    const int shifts[3] = {H1, H1 - 1, H1 + 1};
+    for (int s : shifts) {
+        uint64_t p = (position << s) & (position << (2 * s));
+        r |= p & (position << (3 * s));
+        r |= p & (position >> s);
+        p = (position >> s) & (position >> (2 * s));
+        r |= p & (position << s);
+        r |= p & (position >> (3 * s));
+    }
+    return r & (BOARD ^ mask);
+}
+// --- End Position helpers ---
+
+// Negamax over non-losing moves. Assumes the side to move cannot win
+// immediately (guaranteed by the parent's move filter / the root check).
+int ConnectFourSolver::negamax(const Position& p, int alpha, int beta) {
+    ++nodeCount;
+
+    uint64_t next = p.nonLosingMoves();
+    if (next == 0) return -(CELLS - p.moves) / 2; // Opponent wins with their next stone
+    if (p.moves >= CELLS - 2) return 0;           // Board fills before anyone can win
+
+    // Nobody can win before two more stones, which bounds the score from both sides
+    int minScore = -(CELLS - 2 - p.moves) / 2;
+    if (alpha < minScore) {
+        alpha = minScore;
+        if (alpha >= beta) return alpha;
+    }
+    int maxScore = (CELLS - 1 - p.moves) / 2;
+    if (beta > maxScore) {
+        beta = maxScore;
+        if (alpha >= beta) return beta;
+    }
+
+    const uint64_t key = tableKey(p.key());
+    TranspositionTable::Entry entry;
+    int ttMove = -1;
+    if (table.probe(key, entry)) {
+        ttMove = entry.bestMove;
+        if (entry.bound == TranspositionTable::BOUND_UPPER && beta > entry.score) {
+            beta = entry.score;
+            if (alpha >= beta) return beta;
+        } else if (entry.bound == TranspositionTable::BOUND_LOWER && alpha < entry.score) {
+            alpha = entry.score;
+            if (alpha >= beta) return alpha;
+        }
+    }
+
+    // Order: table move, then most new threats, center-out on ties
+    int order[ConnectFourBoard::COLS];
+    int keys[ConnectFourBoard::COLS];
+    int n = 0;
+    for (int c : CENTER_OUT) {
+        uint64_t move = next & ConnectFourBoard::columnMask(c);
+        if (!move) continue;
+        int k = (c == ttMove) ? 1000 : p.moveScore(move);
+        int j = n++;
+        while (j > 0 && keys[j - 1] < k) {
+            keys[j] = keys[j - 1];
+            order[j] = order[j - 1];
+            --j;
+        }
+        keys[j] = k;
+        order[j] = c;
+    }
+
+    int bestCol = order[0];
+    for (int i = 0; i < n; ++i) {
+        Position child = p;
+        child.play(next & ConnectFourBoard::columnMask(order[i]));
+        int score = -negamax(child, -beta, -alpha);
+        if (score >= beta) {
+            table.store(key, CELLS - p.moves, score, TranspositionTable::BOUND_LOWER, order[i]);
+            return score;
+        }
+        if (score > alpha) {
+            alpha = score;
+            bestCol = order[i];
+        }
+    }
+    // Depth slot holds the empty cells, so replacement keeps the costlier entries
+    table.store(key, CELLS - p.moves, alpha, TranspositionTable::BOUND_UPPER, bestCol);
+    return alpha;
+}
+
+// Exact score by repeated null-window searches that halve the [min, max] interval
+int ConnectFourSolver::solveScore(const Position& p) {
+    if (p.canWinNext()) return (CELLS + 1 - p.moves) / 2;
+
+    int lo = -(CELLS - p.moves) / 2;
+    int hi = (CELLS + 1 - p.moves) / 2;
+    while (lo < hi) {
+        int med = lo + (hi - lo) / 2;
+        // Probe near zero first; most positions are decided by who wins, not when
+        if (med <= 0 && lo / 2 < med) med = lo / 2;
+        else if (med >= 0 && hi / 2 > med) med = hi / 2;
+        int r = negamax(p, med, med + 1);
+        if (r <= med) hi = r;
+        else lo = r;
+    }
+    return lo;
+}
+
+ConnectFourSolver::Result ConnectFourSolver::solve(const ConnectFourBoard& board, int sideToMove) {
+    auto start = chrono::steady_clock::now();
+    Result result;
+    nodeCount = 0;
+
+    const int opponent = 1 - sideToMove;
+    Position p;
+    p.current = board.sideMask(sideToMove);
+    p.mask = board.occupiedMask();
+    p.moves = board.moveCount();
+
+    if (board.hasWon(opponent)) {
+        // Game already over: the opponent's last stone won
+        result.score = -(CELLS + 1 - (p.moves - 1)) / 2;
+    } else if (board.isFull()) {
+        result.score = 0;
+    } else {
+        result.score = solveScore(p);
+
+        // Pick a move that keeps the score
+        uint64_t winning = p.winningPositions() & p.possible();
+        uint64_t candidates = p.nonLosingMoves();
+        bool decided = winning || !candidates; // Every candidate gives the same result
+        if (winning) {
+            candidates = winning;
+        } else if (!candidates) {
+            // Lost next move whatever happens; block one threat if possible
+            uint64_t forced = p.possible() & p.opponentWinningPositions();
+            candidates = forced ? forced : p.possible();
+        }
+        for (int c : CENTER_OUT) {
+            uint64_t move = candidates & ConnectFourBoard::columnMask(c);
+            if (!move) continue;
+            if (result.bestMove == -1) result.bestMove = c; // Fallback
+            if (decided) break;
+            Position child = p;
+            child.play(move);
+            if (negamax(child, -result.score, -result.score + 1) <= -result.score) {
+                result.bestMove = c;
+                break;
+            }
+        }
+
+        // Plies until the end of the game: the winner places stone number m + 1
+        // where score = (CELLS + 1 - m) / 2 and m has the winner's parity
+        if (result.score != 0) {
+            int s = result.score > 0 ? result.score : -result.score;
+            int parity = (p.moves + (result.score > 0 ? 0 : 1)) % 2;
+            int m = CELLS + 1 - 2 * s;
+            if (m % 2 != parity) --m;
+            result.distance = m - p.moves + 1;
+        } else {
+            result.distance = CELLS - p.moves;
+        }
+    }
+
+    result.nodes = nodeCount;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+bool ConnectFourSolver::parseMoves(const string& moves, ConnectFourBoard& board, int& sideToMove, string& error) {
+    board.reset();
+    sideToMove = ConnectFourBoard::HUMAN_SIDE;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        char ch = moves[i];
+        int col = ch - '1';
+        if (col < 0 || col >= ConnectFourBoard::COLS) {
+            error = "invalid column '" + string(1, ch) + "' at move " + to_string(i + 1);
+            return false;
+        }
+        if (board.hasWon(1 - sideToMove)) {
+            error = "move " + to_string(i + 1) + " played after the game was won";
+            return false;
+        }
+        if (!board.canPlay(col)) {
+            error = "column " + string(1, ch) + " is full at move " + to_string(i + 1);
+            return false;
+        }
+        board.play(col, sideToMove);
+        sideToMove = 1 - sideToMove;
+    }
+    return true;
+}
@@ -0,0 +1,73 @@
+#ifndef CONNECTFOURSOLVER_H
+#define CONNECTFOURSOLVER_H
+
+#include "connectfourboard.h"
+#include "transpositiontable.h"
+#include <cstdint>
+#include <string>
+
+// Exact (perfect-play) solver for Connect Four positions.
+//
+// Negamax with alpha-beta over a "side to move" bitboard, driven by a
+// null-window search that narrows the score interval at the root. Moves that
+// hand the opponent an immediate win are filtered out before searching, and
+// the rest are ordered by how many new threats they create.
+//
+// Scores follow the usual convention: 0 is a draw, a positive score means the
+// side to move wins, and larger magnitudes mean earlier results.
+// score = (ROWS * COLS + 1 - stonesBeforeWinningMove) / 2 for the winner.
+class ConnectFourSolver {
+public:
+    struct Result {
+        int score = 0;       // Game-theoretic value for the side to move
+        int bestMove = -1;   // Column achieving `score`, -1 if the game is over
+        int distance = 0;    // Plies until the game ends with perfect play (the remaining cells for a draw)
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+    };
+
+    explicit ConnectFourSolver(size_t transpositionTableMB = 16);
+
+    // Solves `board` with `sideToMove` (ConnectFourBoard::AI_SIDE / HUMAN_SIDE) to play
+    Result solve(const ConnectFourBoard& board, int sideToMove);
+
+    void reset(); // Clears the transposition table
+
+    // Parses a move string of 1-based column digits ("4453"); the first
+    // move is HUMAN_SIDE's. Fails on bad digits, full columns or moves
+    // after the game is already won.
+    static bool parseMoves(const std::string& moves, ConnectFourBoard& board, int& sideToMove, std::string& error);
+
+    // "win", "loss" or "draw" for the side to move
+    static const char* outcome(int score) { return score > 0 ? "win" : score < 0 ? "loss" : "draw"; }
+
+private:
+    // Side-to-move representation used inside the search (copy-make)
+    struct Position {
+        uint64_t current = 0; // Stones of the side to move
+        uint64_t mask = 0;    // All stones
+        int moves = 0;
+
+        uint64_t key() const { return current + mask; } // Unique per position
+        uint64_t possible() const;
+        uint64_t winningPositions() const;
+        uint64_t opponentWinningPositions() const;
+        bool canWinNext() const { return (winningPositions() & possible()) != 0; }
+        uint64_t nonLosingMoves() const;
+        int moveScore(uint64_t move) const;
+        void play(uint64_t move) {
+            current ^= mask;
+            mask |= move;
+            ++moves;
+        }
+    };
+
+    int negamax(const Position& p, int alpha, int beta);
+    int solveScore(const Position& p);
+    static uint64_t winningCells(uint64_t position, uint64_t mask);
+
+    TranspositionTable table;
+    uint64_t nodeCount = 0;
+};
+
+#endif // CONNECTFOURSOLVER_H
@@ -0,0 +1,173 @@
+#include "grundy.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+const uint64_t HeapGame::MAX_MOVE;
+const uint64_t HeapGame::MAX_TABLE;
+
+namespace {
+    int lowestBit(uint64_t x) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(x);
+#else
+        int i = 0;
+        while (!(x & 1)) { x >>= 1; ++i; }
+        return i;
+#endif
+    }
+
+    // mex of the values reachable from heap n: `seen` has one bit per
+    // possible value (at most one per move), cleared again on the way out
+    uint16_t mex(const vector<uint16_t>& values, const vector<uint64_t>& moves, uint64_t n, vector<uint64_t>& seen) {
+        for (uint64_t s : moves) {
+            if (s > n) break;
+            uint16_t v = values[n - s];
+            seen[v >> 6] |= uint64_t(1) << (v & 63);
+        }
+        uint16_t result = 0;
+        for (size_t w = 0; w < seen.size(); ++w) {
+            if (~seen[w]) {
+                result = static_cast<uint16_t>(w * 64 + lowestBit(~seen[w]));
+                break;
+            }
+        }
+        for (uint64_t s : moves) {
+            if (s > n) break;
+            seen[values[n - s] >> 6] = 0;
+        }
+        return result;
+    }
+}
+
+bool HeapGame::subtraction(vector<uint64_t> moves, HeapGame& game, string& error) {
+    sort(moves.begin(), moves.end());
+    moves.erase(unique(moves.begin(), moves.end()), moves.end());
+    if (!moves.empty() && moves.front() == 0) moves.erase(moves.begin());
+    if (moves.empty()) {
+        error = "the move set is empty";
+        return false;
+    }
+    if (moves.back() > MAX_MOVE) {
+        error = "moves may take at most " + to_string(MAX_MOVE) + " items";
+        return false;
+    }
+    game.table = build(moves);
+    return true;
+}
+
+string HeapGame::describe() const {
+    if (isNim()) return "Nim";
+    string s = "S{";
+    for (size_t i = 0; i < table->moves.size(); ++i) {
+        if (i > 0) s += ",";
+        s += to_string(table->moves[i]);
+    }
+    return s + "}";
+}
+
+// --- Table construction ---
+// With largest move M, g(n) depends only on the M values before it, so once
+// g(n + q) == g(n) holds for M consecutive n starting at p, it holds for all
+// n >= p. Tabulating in doubling lengths, each length is checked for the
+// smallest such q, with p the start of its matching tail.
+shared_ptr<const HeapGame::Table> HeapGame::build(const vector<uint64_t>& moves) {
+    static mutex cacheMutex;
+    static map<vector<uint64_t>, shared_ptr<const Table>> cache;
+    lock_guard<mutex> lock(cacheMutex);
+    auto it = cache.find(moves);
+    if (it != cache.end()) return it->second;
+
+    auto t = make_shared<Table>();
+    t->moves = moves;
+    const uint64_t M = moves.back();
+    vector<uint64_t> seen(moves.size() / 64 + 1, 0);
+    vector<uint16_t>& g = t->values;
+
+    uint64_t length = max<uint64_t>(1024, 4 * M);
+    bool found = false;
+    while (!found) {
+        length = min(length, MAX_TABLE);
+        for (uint64_t n = g.size(); n < length; ++n) g.push_back(mex(g, moves, n, seen));
+
+        for (uint64_t q = 1; q + M <= length && !found; ++q) {
+            uint64_t n = length - q; // One past the last comparable value
+            while (n > 0 && g[n - 1] == g[n - 1 + q]) --n;
+            if (length - q - n >= M) {
+                t->preperiod = n;
+                t->period = q;
+                found = true;
+            }
+        }
+        if (length == MAX_TABLE) break;
+        length *= 2;
+    }
+    if (found) {
+        g.resize(t->preperiod + t->period);
+        g.shrink_to_fit();
+    }
+
+    cache[moves] = t;
+    return t;
+}
+// --- End table construction ---
+
+uint64_t HeapGame::preperiod() const { return table ? table->preperiod : 0; }
+uint64_t HeapGame::period() const { return table ? table->period : 0; }
+
+uint64_t HeapGame::grundy(uint64_t heap) const {
+    if (isNim()) return heap;
+    const Table& t = *table;
+    if (heap < t.values.size()) return t.values[heap];
+    if (t.period) return t.values[t.preperiod + (heap - t.preperiod) % t.period];
+    return extrapolate(heap);
+}
+
+// Runs the recurrence past the end of a table that has no period, keeping
+// only the last M values
+uint64_t HeapGame::extrapolate(uint64_t heap) const {
+    const Table& t = *table;
+    const uint64_t M = t.moves.back();
+    vector<uint16_t> window(t.values.end() - M, t.values.end()); // g(n - M .. n - 1), cyclic
+    vector<uint64_t> seen(t.moves.size() / 64 + 1, 0);
+    uint64_t n = t.values.size();
+    size_t head = 0; // Slot of g(n - M)
+    for (;; ++n) {
+        for (uint64_t s : t.moves) {
+            uint16_t v = window[(head + M - s) % M];
+            seen[v >> 6] |= uint64_t(1) << (v & 63);
+        }
+        uint16_t value = 0;
+        for (size_t w = 0; w < seen.size(); ++w) {
+            if (~seen[w]) {
+                value = static_cast<uint16_t>(w * 64 + lowestBit(~seen[w]));
+                break;
+            }
+        }
+        fill(seen.begin(), seen.end(), 0);
+        if (n == heap) return value;
+        window[head] = value;
+        head = (head + 1) % M;
+    }
+}
+
+bool HeapGame::canRemove(uint64_t heap, uint64_t count) const {
+    if (count == 0 || count > heap) return false;
+    return isNim() || binary_search(table->moves.begin(), table->moves.end(), count);
+}
+
+uint64_t HeapGame::smallestMove(uint64_t heap) const {
+    uint64_t s = isNim() ? 1 : table->moves.front();
+    return s <= heap ? s : 0;
+}
+
+uint64_t HeapGame::moveTo(uint64_t heap, uint64_t target) const {
+    if (isNim()) return target < heap ? heap - target : 0;
+    for (uint64_t s : table->moves) {
+        if (s > heap) break;
+        if (grundy(heap - s) == target) return s;
+    }
+    return 0;
+}
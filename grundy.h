@@ -0,0 +1,60 @@
+#ifndef GRUNDY_H
+#define GRUNDY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One heap of an impartial game, valued by Sprague-Grundy theory: under
+// normal play (whoever cannot move loses) a sum of heaps is won by the
+// player to move exactly when the XOR of the heaps' Grundy values is not 0.
+//
+// Nim allows taking any number of items, so a heap's Grundy value is its
+// size. A subtraction game allows taking s items for s in a finite move set;
+// its Grundy values g(n) = mex { g(n - s) : s in the set, s <= n } are
+// always eventually periodic. They are tabulated with a bitset mex until the
+// period shows, then kept as a prefix plus one period, so grundy() is a
+// table lookup for any heap size. Tables are memoized per move set and
+// shared by every HeapGame that uses it.
+class HeapGame {
+public:
+    static const uint64_t MAX_MOVE = 65535;    // Largest subtraction; Grundy values then fit 16 bits
+    static const uint64_t MAX_TABLE = 1 << 22; // Values searched for a period
+
+    HeapGame() = default; // Nim
+
+    // Takes any amount in `moves` (duplicates and zeros are dropped);
+    // false and an error message if the set is empty or a move too large
+    static bool subtraction(std::vector<uint64_t> moves, HeapGame& game, std::string& error);
+
+    bool isNim() const { return table == nullptr; }
+    std::string describe() const; // "Nim" or "S{1,3,4}"
+
+    uint64_t grundy(uint64_t heap) const;
+    bool canRemove(uint64_t heap, uint64_t count) const;
+    uint64_t smallestMove(uint64_t heap) const; // 0 if the heap allows no move
+    // Items to take so the heap's Grundy value becomes `target`, 0 if none
+    uint64_t moveTo(uint64_t heap, uint64_t target) const;
+
+    // Shape of a subtraction game's table (0, 0 for Nim). If no period
+    // turned up within MAX_TABLE values, period is 0 and heaps beyond the
+    // table are evaluated from its end, in time linear in the excess.
+    uint64_t preperiod() const;
+    uint64_t period() const;
+
+private:
+    struct Table {
+        std::vector<uint64_t> moves; // Ascending
+        std::vector<uint16_t> values; // g(0 .. preperiod + period)
+        uint64_t preperiod = 0;
+        uint64_t period = 0;
+    };
+
+    static std::shared_ptr<const Table> build(const std::vector<uint64_t>& moves);
+    uint64_t extrapolate(uint64_t heap) const;
+
+    std::shared_ptr<const Table> table; // Null for Nim
+};
+
+#endif // GRUNDY_H
@@ -11,14 +11,41 @@
 #include "connectfour.h"
 #include "nim.h"
 #include "mazesolver.h"
+#include "commandline.h" // Non-interactive modes
+
+int main(int argc, char* argv[]) {
+    // Any arguments select a headless command instead of the menu
+    if (argc > 1) {
+        return runCommandLine(argc, argv);
+    }
 
-int main() {
     // Use smart pointers to manage game objects polymorphically
     std::vector<std::unique_ptr<Game>> games;
     games.push_back(std::make_unique<TicTacToe>());
+    games.push_back(std::make_unique<TicTacToe>(4, 4, 4));
+    games.push_back(std::make_unique<TicTacToe>(5, 5, 4));
+    games.push_back(std::make_unique<TicTacToe>(15, 15, 5)); // Gomoku
     games.push_back(std::make_unique<ConnectFour>());
+    auto connectFourMCTS = std::make_unique<ConnectFour>();
+    connectFourMCTS->setEngine(ConnectFour::Engine::MCTS);
+    games.push_back(std::move(connectFourMCTS));
+    games.push_back(std::make_unique<ConnectFour8x7>());
+#if defined(__SIZEOF_INT128__)
+    games.push_back(std::make_unique<ConnectFour9x7>());
+#endif
+    games.push_back(std::make_unique<ConnectFive>());
+    games.push_back(std::make_unique<ConnectFour5x4>());
+    games.push_back(std::make_unique<ConnectFour5x5>());
     games.push_back(std::make_unique<Nim>()); // Default Nim piles
-    // games.push_back(std::make_unique<Nim>(std::vector<int>{1, 2, 3, 4})); // Example custom Nim piles
+    // games.push_back(std::make_unique<Nim>(std::vector<uint64_t>{1, 2, 3, 4})); // Example custom Nim piles
+    games.push_back(std::make_unique<Nim>(std::vector<uint64_t>{3, 4, 5}, std::vector<HeapGame>{HeapGame()}, true));
+    HeapGame takeOneThreeFour, takeOneTwo;
+    std::string error; // Fixed move sets, always valid
+    HeapGame::subtraction({1, 3, 4}, takeOneThreeFour, error);
+    HeapGame::subtraction({1, 2}, takeOneTwo, error);
+    games.push_back(std::make_unique<Nim>(std::vector<uint64_t>{7, 10, 15}, std::vector<HeapGame>{takeOneThreeFour}));
+    games.push_back(std::make_unique<Nim>(std::vector<uint64_t>{5, 8, 13},
+                                          std::vector<HeapGame>{HeapGame(), takeOneTwo, takeOneThreeFour}));
     games.push_back(std::make_unique<MazeSolver>("maze.txt")); // Load from file
 
     int choice = 0;
@@ -0,0 +1,168 @@
+#include "mazebitmap.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+const size_t MazeBitmap::ALIGN;
+const uint64_t MazeBitmap::MAX_CELLS;
+
+namespace {
+    const char MAGIC[8] = {'M', 'A', 'Z', 'E', 'B', 'I', 'T', '\0'};
+}
+
+void MazeBitmap::padRow(uint64_t* row, int cols, size_t rowWords) {
+    size_t full = static_cast<size_t>(cols) / 64;
+    if (cols % 64) row[full++] |= ~uint64_t(0) << (cols % 64);
+    for (size_t w = full; w < rowWords; ++w) row[w] = ~uint64_t(0);
+}
+
+void MazeBitmap::clear() {
+    file.close();
+    owned.clear();
+    owned.shrink_to_fit();
+    solid.clear();
+    words = nullptr;
+    rowWords = 0;
+    rows = cols = 0;
+    start = end = Cell();
+}
+
+bool MazeBitmap::create(int newRows, int newCols) {
+    clear();
+    if (newRows <= 0 || newCols <= 0 || static_cast<uint64_t>(newRows) * newCols > MAX_CELLS) return false;
+
+    rows = newRows;
+    cols = newCols;
+    rowWords = rowBytesFor(cols) / sizeof(uint64_t);
+    owned.assign(static_cast<size_t>(rows) * rowWords, 0);
+    for (int r = 0; r < rows; ++r) padRow(owned.data() + static_cast<size_t>(r) * rowWords, cols, rowWords);
+    words = owned.data();
+    solid.assign(rowWords, ~uint64_t(0));
+    return true;
+}
+
+void MazeBitmap::setWall(int r, int c, bool wall) {
+    uint64_t& word = owned[static_cast<size_t>(r) * rowWords + (c >> 6)];
+    uint64_t bit = uint64_t(1) << (c & 63);
+    word = wall ? word | bit : word & ~bit;
+}
+
+bool MazeBitmap::isBinaryFile(const string& path) {
+    ifstream in(path, ios::binary);
+    char magic[sizeof(MAGIC)];
+    return in.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool MazeBitmap::load(const string& path, string& error) {
+    clear();
+    if (!file.open(path)) {
+        error = "cannot map " + path;
+        return false;
+    }
+    Header header;
+    if (file.size() < sizeof(Header)) {
+        file.close();
+        error = path + " is not a binary maze";
+        return false;
+    }
+    memcpy(&header, file.data(), sizeof(Header));
+    uint64_t cells = static_cast<uint64_t>(header.rows) * header.cols;
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.rows == 0 ||
+        header.cols == 0 || header.rows > INT_MAX || header.cols > INT_MAX || cells > MAX_CELLS ||
+        header.rowBytes != rowBytesFor(static_cast<int>(header.cols)) || header.startRow >= header.rows ||
+        header.startCol >= header.cols || header.endRow >= header.rows || header.endCol >= header.cols ||
+        file.size() != sizeof(Header) + static_cast<uint64_t>(header.rows) * header.rowBytes) {
+        file.close();
+        error = path + " is not a binary maze or is truncated";
+        return false;
+    }
+
+    rows = static_cast<int>(header.rows);
+    cols = static_cast<int>(header.cols);
+    rowWords = header.rowBytes / sizeof(uint64_t);
+    start = Cell{static_cast<int>(header.startRow), static_cast<int>(header.startCol)};
+    end = Cell{static_cast<int>(header.endRow), static_cast<int>(header.endCol)};
+    words = reinterpret_cast<const uint64_t*>(file.data() + sizeof(Header)); // Page aligned, so ALIGN too
+    solid.assign(rowWords, ~uint64_t(0));
+    return true;
+}
+
+bool MazeBitmap::convertText(const string& textPath, const string& binaryPath, string& error) {
+    ifstream in(textPath, ios::binary);
+    if (!in) {
+        error = "cannot open " + textPath;
+        return false;
+    }
+    ofstream out(binaryPath, ios::binary | ios::trunc);
+    if (!out) {
+        error = "cannot create " + binaryPath;
+        return false;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header)); // Rewritten once the size is known
+
+    bool foundStart = false, foundEnd = false;
+    vector<uint64_t> bits;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue; // Like the text loader
+
+        if (header.rows == 0) {
+            if (line.size() > INT_MAX) {
+                error = "rows are too long";
+                return false;
+            }
+            header.cols = static_cast<uint32_t>(line.size());
+            header.rowBytes = static_cast<uint32_t>(rowBytesFor(static_cast<int>(header.cols)));
+            bits.resize(header.rowBytes / sizeof(uint64_t));
+        } else if (line.size() != header.cols) {
+            error = "row " + to_string(header.rows) + " has " + to_string(line.size()) + " cells, expected " +
+                    to_string(header.cols);
+            return false;
+        }
+        if ((static_cast<uint64_t>(header.rows) + 1) * header.cols > MAX_CELLS) {
+            error = "the maze has more than " + to_string(MAX_CELLS) + " cells";
+            return false;
+        }
+
+        fill(bits.begin(), bits.end(), 0);
+        for (uint32_t c = 0; c < header.cols; ++c) {
+            char cell = line[c];
+            if (cell == '#') {
+                bits[c >> 6] |= uint64_t(1) << (c & 63);
+            } else if (cell == 'S') {
+                header.startRow = header.rows;
+                header.startCol = c;
+                foundStart = true;
+            } else if (cell == 'E') {
+                header.endRow = header.rows;
+                header.endCol = c;
+                foundEnd = true;
+            }
+        }
+        padRow(bits.data(), static_cast<int>(header.cols), bits.size());
+        out.write(reinterpret_cast<const char*>(bits.data()), static_cast<streamsize>(header.rowBytes));
+        ++header.rows;
+    }
+
+    if (header.rows == 0 || !foundStart || !foundEnd) {
+        error = header.rows == 0 ? "the maze is empty" : "the maze has no start ('S') or end ('E')";
+        return false;
+    }
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (!out) {
+        error = "cannot write " + binaryPath;
+        return false;
+    }
+    return true;
+}
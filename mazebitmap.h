@@ -0,0 +1,80 @@
+#ifndef MAZEBITMAP_H
+#define MAZEBITMAP_H
+
+#include "mappedfile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Walls of a grid maze, one bit per cell (1 = wall), either built in memory
+// or mapped straight from a binary maze file, so even a 50000 x 50000 maze
+// costs about 300 MB and opening it parses nothing.
+//
+// Rows are padded to a multiple of ALIGN bytes, so every row starts on a
+// cache line and can be read as whole 64-bit words; the padding bits are
+// walls, so a scan along a row stops at its end like at any other wall.
+//
+// File layout (little-endian):
+//   Header { char magic[8] = "MAZEBIT"; uint32 version; uint32 rows, cols;
+//            uint32 startRow, startCol, endRow, endCol; uint32 rowBytes;
+//            padding to 64 bytes }
+//   rows * rowBytes bytes of walls, cell c of a row at bit c % 64 of the
+//   row's 64-bit word c / 64
+class MazeBitmap {
+public:
+    static const size_t ALIGN = 64;
+    static const uint64_t MAX_CELLS = UINT32_MAX; // Cell indexes fit 32 bits
+
+    // All cells open; false if the maze is empty or too large
+    bool create(int rows, int cols);
+    bool load(const std::string& path, std::string& error); // Maps a binary maze file
+    void clear();
+    static bool isBinaryFile(const std::string& path);       // Starts with the magic
+
+    // Streams a text maze ('#' walls, 'S' start, 'E' end, anything else
+    // open) into a binary maze file, one row in memory at a time
+    static bool convertText(const std::string& textPath, const std::string& binaryPath, std::string& error);
+
+    struct Cell { int r = -1, c = -1; };
+
+    bool isLoaded() const { return words != nullptr; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    // From the file header; (-1, -1) for a bitmap built with create()
+    Cell getStart() const { return start; }
+    Cell getEnd() const { return end; }
+
+    size_t wordsPerRow() const { return rowWords; }
+    const uint64_t* row(int r) const { return words + static_cast<size_t>(r) * rowWords; }
+    // Row r, or all walls for the rows just outside the maze
+    const uint64_t* rowOrSolid(int r) const { return r >= 0 && r < rows ? row(r) : solid.data(); }
+    bool isWall(int r, int c) const { return (row(r)[c >> 6] >> (c & 63)) & 1; }
+    void setWall(int r, int c, bool wall); // Built bitmaps only
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t rows, cols;
+        uint32_t startRow, startCol, endRow, endCol;
+        uint32_t rowBytes;
+        uint8_t padding[ALIGN - 40];
+    };
+    static_assert(sizeof(Header) == ALIGN, "walls must start on a row boundary");
+
+    static const uint32_t VERSION = 1;
+
+    static size_t rowBytesFor(int cols) { return (static_cast<size_t>(cols) + 8 * ALIGN - 1) / (8 * ALIGN) * ALIGN; }
+    static void padRow(uint64_t* row, int cols, size_t rowWords); // Walls past the last column
+
+    MappedFile file;
+    std::vector<uint64_t> owned; // Storage of a built bitmap
+    std::vector<uint64_t> solid; // One row of walls
+    const uint64_t* words = nullptr;
+    size_t rowWords = 0;
+    int rows = 0, cols = 0;
+    Cell start, end;
+};
+
+#endif // MAZEBITMAP_H
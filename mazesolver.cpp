@@ -6,11 +6,12 @@
 #include <vector>
 #include <string>
 #include <queue>
-#include <map>
+#include <new>          // For bad_alloc
 #include <cmath>        // For abs()
 #include <limits>       // For infinity
 #include <chrono>       // For sleep duration
-#include <thread>       // For this_thread::sleep_for
+#include <thread>       // For this_thread::sleep_for and bidirectional search
+#include <mutex>
 #include <iomanip>      // For setw (optional formatting)
 
 // Add this line after includes
@@ -19,9 +20,36 @@ using namespace std;
 // Adjust delay for visualization speed (milliseconds)
 const int VISUALIZATION_DELAY_MS = 50; // Lower value = faster, Higher = slower
 
+// Moves (Up, Down, Left, Right)
+const int DR[4] = {-1, 1, 0, 0};
+const int DC[4] = {0, 0, -1, 1};
+const int UP = 0, DOWN = 1, LEFT = 2, RIGHT = 3;
+
+namespace {
+    int lowestBit(uint64_t x) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(x);
+#else
+        int i = 0;
+        while (!(x & 1)) { x >>= 1; ++i; }
+        return i;
+#endif
+    }
+
+    int highestBit(uint64_t x) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(x);
+#else
+        int i = 63;
+        while (!(x >> 63)) { x <<= 1; --i; }
+        return i;
+#endif
+    }
+}
+
 // --- Constructor and Loading Logic (logic unchanged, just removed std::) ---
-MazeSolver::MazeSolver(const string& filename) {
-    if (!loadMaze(filename)) {
+MazeSolver::MazeSolver(const string& filename, bool useDefaultOnFailure) {
+    if (!loadMaze(filename) && useDefaultOnFailure) {
         cout << Color::BOLD_RED << "Failed to load maze from '" << filename << "'. Using default maze.\n" << Color::RESET;
         // Define a simple default maze if loading fails
         grid = {
@@ -46,11 +74,31 @@ MazeSolver::MazeSolver(const string& filename) {
               cerr << Color::BOLD_RED << "Error: Default maze is missing Start ('S') or End ('E').\n" << Color::RESET;
               grid.clear();
               rows = 0; cols = 0;
+         } else {
+              buildWalls();
          }
     }
 }
 
 bool MazeSolver::loadMaze(const string& filename) {
+    walls.clear();
+    jumpTable.clear();
+    if (MazeBitmap::isBinaryFile(filename)) {
+        // Mapped, not read: the walls are paged in as the search reaches them
+        grid.clear();
+        string error;
+        if (!walls.load(filename, error)) {
+            cerr << Color::BOLD_RED << "Error: " << error << ".\n" << Color::RESET;
+            rows = cols = 0;
+            return false;
+        }
+        rows = walls.getRows();
+        cols = walls.getCols();
+        startPoint = Point{walls.getStart().r, walls.getStart().c};
+        endPoint = Point{walls.getEnd().r, walls.getEnd().c};
+        return true;
+    }
+
     ifstream file(filename);
     if (!file) {
         cerr << Color::BOLD_RED << "Error: Cannot open maze file '" << filename << "'.\n" << Color::RESET;
@@ -111,6 +159,20 @@ bool MazeSolver::loadMaze(const string& filename) {
          grid.clear(); return false;
      }
 
+    return buildWalls();
+}
+
+bool MazeSolver::buildWalls() {
+    if (!walls.create(rows, cols)) {
+        cerr << Color::BOLD_RED << "Error: The maze has more than " << MazeBitmap::MAX_CELLS << " cells.\n" << Color::RESET;
+        grid.clear();
+        return false;
+    }
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (grid[r][c] == WALL) walls.setWall(r, c, true);
+        }
+    }
     return true;
 }
 // --- End Loading Logic ---
@@ -118,6 +180,10 @@ bool MazeSolver::loadMaze(const string& filename) {
 
 // --- Modified displayMaze with Enhanced UI ---
 void MazeSolver::displayMaze(bool showVisited) const {
+    displayMaze(grid, showVisited);
+}
+
+void MazeSolver::displayMaze(const vector<string>& cells, bool showVisited) const {
     cout << "\n" << Color::WHITE << "Maze (" << rows << "x" << cols << "):" << Color::RESET << "\n";
     // Top border
     cout << Color::WHITE << " +" << string(cols, '-') << "+" << Color::RESET << "\n";
@@ -126,8 +192,8 @@ void MazeSolver::displayMaze(bool showVisited) const {
         cout << Color::WHITE << " |" << Color::RESET; // Left border
         for (int c = 0; c < cols; ++c) {
             // Check bounds before accessing grid element
-            if (r >= 0 && r < grid.size() && c >= 0 && c < grid[r].size()) {
-                char cell = grid[r][c];
+            if (static_cast<size_t>(r) < cells.size() && static_cast<size_t>(c) < cells[r].size()) {
+                char cell = cells[r][c];
                 // Choose color based on cell type
                 switch(cell) {
                     case WALL:          cout << Color::WHITE << '#' << Color::RESET; break; // White Wall
@@ -163,144 +229,523 @@ void MazeSolver::displayMaze(bool showVisited) const {
 // --- End displayMaze ---
 
 
-// --- Game Logic (isValid, calculateHeuristic, reconstructPath) - logic unchanged ---
+// --- Game Logic (isValid, calculateHeuristic, reconstructPath) ---
 bool MazeSolver::isValid(int r, int c) const {
-    return r >= 0 && r < rows && c >= 0 && c < cols && grid[r][c] != WALL;
+    return r >= 0 && r < rows && c >= 0 && c < cols && !walls.isWall(r, c);
 }
 
 int MazeSolver::calculateHeuristic(Point a, Point b) const {
     return abs(a.r - b.r) + abs(a.c - b.c);
 }
 
-void MazeSolver::reconstructPath(const map<int, Point>& cameFrom, Point current) {
-     Point temp = current;
-     int currentIdx = pointToIndex(temp);
-     while (cameFrom.count(currentIdx)) {
-         temp = cameFrom.at(currentIdx);
-         currentIdx = pointToIndex(temp);
-         if (temp.r == startPoint.r && temp.c == startPoint.c) break; // Stop if we backtrack to start
-
-         // Only mark PATH cells as SOLUTION_PATH
-         if (grid[temp.r][temp.c] == PATH || grid[temp.r][temp.c] == VISITED) {
-             grid[temp.r][temp.c] = SOLUTION_PATH;
+vector<MazeSolver::Point> MazeSolver::reconstructPath(uint32_t pathCost) const {
+     vector<Point> path(static_cast<size_t>(pathCost) + 1);
+     Point current = endPoint;
+     path[pathCost] = current;
+     // Walk back through closed cells, one unit of cost per step
+     for (uint32_t g = pathCost; g > 0; --g) {
+         for (int i = 0; i < 4; ++i) {
+             Point previous{current.r - DR[i], current.c - DC[i]};
+             if (!isValid(previous.r, previous.c)) continue;
+             uint32_t index = pointToIndex(previous);
+             if (isClosed(index) && closedTag(index) == ((g - 1) & 3)) {
+                 current = previous;
+                 break;
+             }
          }
-         // Safety check (optional, A* shouldn't cycle)
-         // if (currentIdx == pointToIndex(cameFrom.at(currentIdx))) break;
+         path[g - 1] = current;
      }
+     return path;
+}
+
+void MazeSolver::prepareSearch() {
+    size_t bytes = (static_cast<size_t>(rows) * cols + 1) / 2;
+    if (closedBytes != bytes || generation == 3) { // New size, or generations about to repeat
+        closedCells.reset(static_cast<uint8_t*>(calloc(bytes, 1)));
+        if (!closedCells) throw bad_alloc();
+        closedBytes = bytes;
+        generation = 0;
+    }
+    ++generation;
 }
 // --- End Game Logic ---
 
 
-// --- Modified solveAStar with Enhanced Visualization Output ---
-bool MazeSolver::solveAStar() {
-    // Use a copy for visualization steps
-    vector<string> displayGrid = grid;
+// --- A* search ---
+// `visit` sees every expanded cell; solve() passes a no-op lambda when there
+// is no observer, which compiles to the bare search loop.
+template <class Visit>
+bool MazeSolver::searchAStar(Visit& visit, SolveResult& result, uint32_t& pathCost) {
+    // No per-cell initialization: nibbles from earlier searches are simply stale
+    prepareSearch();
 
-    // Priority queue (min-heap based on fCost)
-    priority_queue<Node, vector<Node>, greater<Node>> openSet;
-    // Map to track path predecessors
-    map<int, Point> cameFrom;
-    // Map to store the cheapest cost found so far to reach a node
-    map<int, int> gCost;
+    // Priority queue (min-heap on the packed f-cost)
+    priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry>> openSet;
+    openSet.push(heapEntry(0, calculateHeuristic(startPoint, endPoint), pointToIndex(startPoint)));
+    ++result.heapPushes;
 
-    // Initialize gCost for all nodes to infinity
+    // Main A* loop
+    while (!openSet.empty()) {
+        HeapEntry top = openSet.top(); // Get node with lowest fCost
+        openSet.pop();
+        ++result.heapPops;
+        uint32_t currentIdx = top.index;
+
+        // The cheapest entry of a cell is popped first, so any later one is
+        // stale (the Manhattan heuristic is consistent)
+        if (isClosed(currentIdx)) continue;
+        Point current = indexToPoint(currentIdx);
+        uint32_t f = static_cast<uint32_t>(top.key >> 32);
+        uint32_t g = f - static_cast<uint32_t>(top.key);
+        close(currentIdx, g);
+        ++result.expanded;
+        visit(current, g, f);
+
+        // Goal check
+        if (current.r == endPoint.r && current.c == endPoint.c) {
+            pathCost = g;
+            return true; // Path found
+        }
+
+        // Explore neighbors (Up, Down, Left, Right); cost to move to a neighbor is 1
+        for (int i = 0; i < 4; ++i) {
+            Point neighbor{current.r + DR[i], current.c + DC[i]};
+            if (!isValid(neighbor.r, neighbor.c)) continue;
+            uint32_t neighborIdx = pointToIndex(neighbor);
+            if (isClosed(neighborIdx)) continue; // Already reached by a shortest path
+            openSet.push(heapEntry(g + 1, calculateHeuristic(neighbor, endPoint), neighborIdx));
+            ++result.heapPushes;
+        }
+    } // End while loop
+
+    return false; // No path found (openSet is empty)
+}
+// --- End A* search ---
+
+
+// --- Jump Point Search ---
+// Forced turns at (r, c) when moving by dc along row r: a vertical
+// neighbour is open while the one beside the previous cell is a wall.
+// Word by word that is ~A & (A shifted by one cell towards the mover), for
+// the rows A above and below; the scan stops at the first forced cell, the
+// end, or a wall (padding bits are walls, and column 0 ends a left scan).
+int MazeSolver::scanRow(int r, int c, int dc) const {
+    const uint64_t* row = walls.row(r);
+    const uint64_t* above = walls.rowOrSolid(r - 1);
+    const uint64_t* below = walls.rowOrSolid(r + 1);
+    const int words = static_cast<int>(walls.wordsPerRow());
+    const int goal = r == endPoint.r ? endPoint.c : -1;
+
+    if (dc > 0) {
+        int from = c + 1;
+        uint64_t mask = ~uint64_t(0) << (from & 63);
+        for (int w = from >> 6; w < words; ++w, mask = ~uint64_t(0)) {
+            uint64_t carryA = w > 0 ? above[w - 1] >> 63 : 1;
+            uint64_t carryB = w > 0 ? below[w - 1] >> 63 : 1;
+            uint64_t forced = (~above[w] & (above[w] << 1 | carryA)) | (~below[w] & (below[w] << 1 | carryB));
+            uint64_t stops = row[w] | forced;
+            if (goal >> 6 == w) stops |= uint64_t(1) << (goal & 63);
+            stops &= mask;
+            if (stops) {
+                int bit = lowestBit(stops);
+                return (row[w] >> bit) & 1 ? -1 : w * 64 + bit;
+            }
+        }
+    } else {
+        int from = c - 1;
+        if (from < 0) return -1;
+        uint64_t mask = ~uint64_t(0) >> (63 - (from & 63));
+        for (int w = from >> 6; w >= 0; --w, mask = ~uint64_t(0)) {
+            uint64_t carryA = w + 1 < words ? above[w + 1] << 63 : uint64_t(1) << 63;
+            uint64_t carryB = w + 1 < words ? below[w + 1] << 63 : uint64_t(1) << 63;
+            uint64_t forced = (~above[w] & (above[w] >> 1 | carryA)) | (~below[w] & (below[w] >> 1 | carryB));
+            uint64_t stops = row[w] | forced;
+            if (goal >= 0 && goal >> 6 == w) stops |= uint64_t(1) << (goal & 63);
+            stops &= mask;
+            if (stops) {
+                int bit = highestBit(stops);
+                return (row[w] >> bit) & 1 ? -1 : w * 64 + bit;
+            }
+        }
+    }
+    return -1;
+}
+
+void MazeSolver::buildJumpTable() {
+    jumpTable.assign(static_cast<size_t>(rows) * cols * 4, 0);
+    auto jump = [&](int r, int c, int direction) -> int32_t& {
+        return jumpTable[(static_cast<size_t>(r) * cols + c) * 4 + direction];
+    };
+    // One step further than the next cell's distance, whatever its sign
+    auto extend = [](int32_t next) { return next > 0 ? next + 1 : next - 1; };
+
+    // Horizontal stops depend only on the row and its neighbours
     for (int r = 0; r < rows; ++r) {
+        for (int c = cols - 1; c >= 0; --c) {
+            if (!isValid(r, c)) continue;
+            int n = c + 1;
+            if (!isValid(r, n)) jump(r, c, RIGHT) = 0;
+            else if ((isValid(r - 1, n) && !isValid(r - 1, c)) || (isValid(r + 1, n) && !isValid(r + 1, c))) jump(r, c, RIGHT) = 1;
+            else jump(r, c, RIGHT) = extend(jump(r, n, RIGHT));
+        }
         for (int c = 0; c < cols; ++c) {
-            gCost[pointToIndex(Point{r,c})] = numeric_limits<int>::max();
+            if (!isValid(r, c)) continue;
+            int n = c - 1;
+            if (!isValid(r, n)) jump(r, c, LEFT) = 0;
+            else if ((isValid(r - 1, n) && !isValid(r - 1, c)) || (isValid(r + 1, n) && !isValid(r + 1, c))) jump(r, c, LEFT) = 1;
+            else jump(r, c, LEFT) = extend(jump(r, n, LEFT));
+        }
+    }
+    // A vertical jump stops where a horizontal one would find a stop
+    for (int c = 0; c < cols; ++c) {
+        for (int r = rows - 1; r >= 0; --r) {
+            if (!isValid(r, c)) continue;
+            int n = r + 1;
+            if (!isValid(n, c)) jump(r, c, DOWN) = 0;
+            else if (jump(n, c, LEFT) > 0 || jump(n, c, RIGHT) > 0) jump(r, c, DOWN) = 1;
+            else jump(r, c, DOWN) = extend(jump(n, c, DOWN));
+        }
+        for (int r = 0; r < rows; ++r) {
+            if (!isValid(r, c)) continue;
+            int n = r - 1;
+            if (!isValid(n, c)) jump(r, c, UP) = 0;
+            else if (jump(n, c, LEFT) > 0 || jump(n, c, RIGHT) > 0) jump(r, c, UP) = 1;
+            else jump(r, c, UP) = extend(jump(n, c, UP));
         }
     }
+}
 
-    // Check start point validity before using it
-    if (startPoint.r < 0 || startPoint.r >= rows || startPoint.c < 0 || startPoint.c >= cols) {
-         cerr << Color::BOLD_RED << "Error: Invalid start point coordinates for A*.\n" << Color::RESET;
-         return false;
+int MazeSolver::jumpRow(Point from, int direction, bool useTable) const {
+    if (!useTable) return scanRow(from.r, from.c, DC[direction]);
+
+    // The table knows no end point: take it if it comes before the stop
+    int32_t d = jumpTable[static_cast<size_t>(pointToIndex(from)) * 4 + direction];
+    if (from.r == endPoint.r) {
+        int k = (endPoint.c - from.c) * DC[direction];
+        if (k > 0 && k <= (d > 0 ? d : -d)) return endPoint.c;
     }
+    return d > 0 ? from.c + d * DC[direction] : -1;
+}
 
-    // Initialize start node
-    gCost[pointToIndex(startPoint)] = 0;
-    Node startNode;
-    startNode.pos = startPoint;
-    startNode.gCost = 0;
-    startNode.hCost = calculateHeuristic(startPoint, endPoint);
-    startNode.parent = Point{-1, -1}; // No parent for start
-    openSet.push(startNode);
+int MazeSolver::jumpColumn(Point from, int direction, bool useTable) const {
+    const int dr = DR[direction];
+    if (!useTable) {
+        for (int r = from.r + dr; isValid(r, from.c); r += dr) {
+            if ((r == endPoint.r && from.c == endPoint.c) || scanRow(r, from.c, -1) >= 0 || scanRow(r, from.c, 1) >= 0) return r;
+        }
+        return -1;
+    }
+
+    int32_t d = jumpTable[static_cast<size_t>(pointToIndex(from)) * 4 + direction];
+    int k = (endPoint.r - from.r) * dr; // Steps to the end point's row
+    int open = d > 0 ? d - 1 : -d;      // Open cells before the stop, if any
+    if (k > 0 && k <= open) {
+        // The end point's row stops the jump if the end is in plain sight
+        // from it; a stop in between would have stopped the jump earlier
+        int side = endPoint.c < from.c ? LEFT : RIGHT;
+        int32_t h = from.c == endPoint.c ? 0 : jumpTable[static_cast<size_t>(pointToIndex(Point{endPoint.r, from.c})) * 4 + side];
+        if (abs(endPoint.c - from.c) <= (h > 0 ? h : -h)) return endPoint.r;
+    }
+    return d > 0 ? from.r + d * dr : -1;
+}
+
+template <class Visit>
+bool MazeSolver::searchJPS(Visit& visit, SolveResult& result, uint32_t& pathCost, bool useTable) {
+    prepareSearch();
+    jumpLog.clear();
+    priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry>> openSet;
+    auto push = [&](Point p, uint32_t g, uint32_t parent) {
+        uint32_t index = pointToIndex(p);
+        if (isClosed(index)) return;
+        openSet.push(heapEntry(g, calculateHeuristic(p, endPoint), index, parent));
+        ++result.heapPushes;
+    };
+    push(startPoint, 0, NO_PARENT);
 
-    // Main A* loop
     while (!openSet.empty()) {
-        Node current = openSet.top(); // Get node with lowest fCost
+        HeapEntry top = openSet.top();
         openSet.pop();
-        int currentIdx = pointToIndex(current.pos);
+        ++result.heapPops;
+        if (isClosed(top.index)) continue;
+        Point current = indexToPoint(top.index);
+        uint32_t f = static_cast<uint32_t>(top.key >> 32);
+        uint32_t g = f - static_cast<uint32_t>(top.key);
+        close(top.index, 0);
+        uint32_t position = static_cast<uint32_t>(jumpLog.size());
+        jumpLog.push_back(JumpPoint{top.index, top.parent});
+        ++result.expanded;
+        visit(current, g, f);
+
+        if (current.r == endPoint.r && current.c == endPoint.c) {
+            pathCost = g;
+            return true;
+        }
 
-        // Optimization: If this node was already processed via a shorter path, skip.
-        // (Requires tracking closed set or comparing current.gCost > gCost[currentIdx])
-        // For simplicity, we rely on the gCost check below.
+        // Directions a canonical path may leave in, given the one it came in
+        bool leave[4] = {true, true, true, true};
+        Point parent = top.parent == NO_PARENT ? current : indexToPoint(jumpLog[top.parent].index);
+        if (parent.c == current.c && parent.r != current.r) {
+            leave[parent.r < current.r ? UP : DOWN] = false;
+        } else if (parent.c != current.c) {
+            int back = parent.c < current.c ? current.c - 1 : current.c + 1;
+            leave[parent.c < current.c ? LEFT : RIGHT] = false;
+            leave[UP] = isValid(current.r - 1, current.c) && !isValid(current.r - 1, back);
+            leave[DOWN] = isValid(current.r + 1, current.c) && !isValid(current.r + 1, back);
+        }
 
+        for (int i = 0; i < 4; ++i) {
+            if (!leave[i]) continue;
+            if (i == UP || i == DOWN) {
+                int r = jumpColumn(current, i, useTable);
+                if (r >= 0) push(Point{r, current.c}, g + abs(r - current.r), position);
+            } else {
+                int c = jumpRow(current, i, useTable);
+                if (c >= 0) push(Point{current.r, c}, g + abs(c - current.c), position);
+            }
+        }
+    }
+    return false;
+}
 
-        // --- Visualization Step ---
-        // Mark current node as visited on the temporary display grid
-        if (displayGrid[current.pos.r][current.pos.c] != START && displayGrid[current.pos.r][current.pos.c] != END) {
-             displayGrid[current.pos.r][current.pos.c] = VISITED;
+vector<MazeSolver::Point> MazeSolver::reconstructJumpPath(uint32_t pathCost) const {
+    vector<Point> path(static_cast<size_t>(pathCost) + 1);
+    Point current = endPoint;
+    size_t k = pathCost;
+    path[k] = current;
+    // Back along each jump, one cell at a time
+    for (uint32_t position = jumpLog.back().parent; k > 0; position = jumpLog[position].parent) {
+        Point parent = indexToPoint(jumpLog[position].index);
+        int dr = parent.r < current.r ? -1 : parent.r > current.r ? 1 : 0;
+        int dc = parent.c < current.c ? -1 : parent.c > current.c ? 1 : 0;
+        while (current.r != parent.r || current.c != parent.c) {
+            current = Point{current.r + dr, current.c + dc};
+            path[--k] = current;
         }
-        clearScreen();
-        cout << Color::BOLD_YELLOW << "=== Maze Solver (A*) - Searching... ===" << Color::RESET << "\n";
+    }
+    return path;
+}
+// --- End Jump Point Search ---
 
-        // Display the current state using the enhanced displayMaze
-        // Temporarily assign displayGrid to the object's grid for the function call
-        vector<string> backupGrid = this->grid;
-        this->grid = displayGrid;
-        displayMaze(true); // Show visited nodes during search
-        this->grid = backupGrid; // Restore the actual grid
 
-        // Print status message
-        cout << " Exploring: (" << Color::CYAN << current.pos.r << Color::RESET << ","
-             << Color::CYAN << current.pos.c << Color::RESET << ") "
-             << " fCost=" << Color::YELLOW << current.fCost() << Color::RESET
-             << " (g=" << current.gCost << ", h=" << current.hCost << ")" << "\n";
-        cout.flush(); // Ensure output is visible before sleep
-        this_thread::sleep_for(chrono::milliseconds(VISUALIZATION_DELAY_MS));
-        // --- End Visualization Step ---
+// --- Bidirectional A* ---
+MazeSolver::SearchSide::SearchSide(uint64_t cells)
+    : blockCount(static_cast<size_t>((cells >> DISTANCE_BLOCK_BITS) + 1)) {
+    blocks.reset(new atomic<atomic<uint32_t>*>[blockCount]());
+}
 
+MazeSolver::SearchSide::~SearchSide() {
+    for (size_t b = 0; b < blockCount; ++b) delete[] blocks[b].load(memory_order_relaxed);
+}
 
-        // Goal check
-        if (current.pos.r == endPoint.r && current.pos.c == endPoint.c) {
-            reconstructPath(cameFrom, current.pos); // Modify the member 'grid' with the solution path
-            return true; // Path found
-        }
+void MazeSolver::SearchSide::setDistance(uint32_t index, uint32_t distance) {
+    atomic<atomic<uint32_t>*>& slot = blocks[index >> DISTANCE_BLOCK_BITS];
+    atomic<uint32_t>* block = slot.load(memory_order_relaxed);
+    if (!block) {
+        block = new atomic<uint32_t>[size_t(1) << DISTANCE_BLOCK_BITS]();
+        slot.store(block);
+    }
+    block[index & ((1u << DISTANCE_BLOCK_BITS) - 1)].store(distance);
+}
+
+void MazeSolver::startSide(SearchSide& side, Point from, Point target) const {
+    side.target = target;
+    uint32_t index = pointToIndex(from);
+    side.setDistance(index, 1);
+    side.openSet.push(meetingEntry(0, calculateHeuristic(from, target), index));
+    side.frontier.store(calculateHeuristic(from, target));
+    side.heapPushes = 1;
+}
 
-        // Explore neighbors (Up, Down, Left, Right)
-        int dr[] = {-1, 1, 0, 0};
-        int dc[] = {0, 0, -1, 1};
+template <class Visit>
+bool MazeSolver::expandSide(SearchSide& side, const SearchSide& other, atomic<uint64_t>& best, Visit& visit) {
+    while (!side.openSet.empty()) {
+        HeapEntry top = side.openSet.top();
+        uint32_t priority = static_cast<uint32_t>(top.key >> 32);
+        if (priority != side.frontier.load(memory_order_relaxed)) side.frontier.store(priority, memory_order_relaxed);
+        uint32_t bound = min(priority, other.frontier.load(memory_order_relaxed));
+        if (bound >= best.load(memory_order_relaxed) >> 32) return false; // No path shorter than mu is left
+        side.openSet.pop();
+        ++side.heapPops;
+        // The priority is f = g + h or 2g, whichever is larger, and the
+        // smaller of priority - h and priority / 2 is g either way
+        uint32_t h = static_cast<uint32_t>(top.key);
+        uint32_t g = min(priority - h, priority / 2);
+        // Entries are only pushed for a lower g, so all but the cheapest are stale
+        if (side.distance(top.index, memory_order_relaxed) != g + 1) continue;
+        Point current = indexToPoint(top.index);
+        ++side.expanded;
+        visit(current, g, g + h);
 
         for (int i = 0; i < 4; ++i) {
-            int nr = current.pos.r + dr[i];
-            int nc = current.pos.c + dc[i];
-            Point neighborPos = Point{nr, nc};
-
-            // Use the member 'grid' for validity checks (walls don't change)
-            if (isValid(nr, nc)) {
-                int neighborIdx = pointToIndex(neighborPos);
-                int tentative_gCost = gCost[currentIdx] + 1; // Cost to move to neighbor is 1
-
-                // If this path to the neighbor is better than any previous one found
-                if (tentative_gCost < gCost[neighborIdx]) {
-                    // Update path information
-                    cameFrom[neighborIdx] = current.pos;
-                    gCost[neighborIdx] = tentative_gCost;
-
-                    // Create neighbor node and add to open set
-                    Node neighborNode;
-                    neighborNode.pos = neighborPos;
-                    neighborNode.gCost = tentative_gCost;
-                    neighborNode.hCost = calculateHeuristic(neighborPos, endPoint);
-                    // neighborNode.parent = current.pos; // Parent info is in cameFrom map
-
-                    openSet.push(neighborNode);
+            Point neighbor{current.r + DR[i], current.c + DC[i]};
+            if (!isValid(neighbor.r, neighbor.c)) continue;
+            uint32_t neighborIdx = pointToIndex(neighbor);
+            uint32_t reached = side.distance(neighborIdx, memory_order_relaxed);
+            if (reached != 0 && reached <= g + 2) continue; // Not a shorter way there
+            side.setDistance(neighborIdx, g + 2);
+            side.openSet.push(meetingEntry(g + 1, calculateHeuristic(neighbor, side.target), neighborIdx));
+            ++side.heapPushes;
+
+            uint32_t fromOther = other.distance(neighborIdx);
+            if (fromOther == 0) continue;
+            uint64_t offer = (uint64_t(g + fromOther) << 32) | neighborIdx; // (g + 1) + (fromOther - 1)
+            uint64_t known = best.load(memory_order_relaxed);
+            while (offer < known && !best.compare_exchange_weak(known, offer, memory_order_relaxed)) {}
+        }
+        return true;
+    }
+    return false; // Everything this side can reach is expanded
+}
+
+template <class Visit>
+bool MazeSolver::searchBidirectional(Visit& visit, SolveResult& result, bool threaded) {
+    SearchSide forward(static_cast<uint64_t>(rows) * cols), backward(static_cast<uint64_t>(rows) * cols);
+    startSide(forward, startPoint, endPoint);
+    startSide(backward, endPoint, startPoint);
+    uint32_t startIdx = pointToIndex(startPoint);
+    atomic<uint64_t> best{startIdx == pointToIndex(endPoint) ? uint64_t(startIdx) : NO_MEETING};
+
+    if (threaded) {
+        // Either side ending the search ends it for both
+        atomic<bool> over{false};
+        auto run = [&](SearchSide& side, const SearchSide& other) {
+            while (!over.load(memory_order_relaxed) && expandSide(side, other, best, visit)) {}
+            over.store(true, memory_order_relaxed);
+        };
+        thread backwardThread(run, ref(backward), cref(forward));
+        run(forward, backward);
+        backwardThread.join();
+    } else {
+        // Expand the lowest priority of either side, the smaller frontier on
+        // a tie (the h parts of the keys measure towards different ends)
+        while (!forward.openSet.empty() && !backward.openSet.empty()) {
+            uint32_t forwardPriority = static_cast<uint32_t>(forward.openSet.top().key >> 32);
+            uint32_t backwardPriority = static_cast<uint32_t>(backward.openSet.top().key >> 32);
+            bool forwardTurn = forwardPriority != backwardPriority ? forwardPriority < backwardPriority
+                                                                   : forward.openSet.size() <= backward.openSet.size();
+            if (forwardTurn ? !expandSide(forward, backward, best, visit) : !expandSide(backward, forward, best, visit)) break;
+        }
+    }
+
+    result.expandedForward = forward.expanded;
+    result.expandedBackward = backward.expanded;
+    result.expanded = forward.expanded + backward.expanded;
+    result.heapPushes = forward.heapPushes + backward.heapPushes;
+    result.heapPops = forward.heapPops + backward.heapPops;
+    uint64_t meeting = best.load();
+    if (meeting == NO_MEETING) return false;
+    result.path = reconstructBidirectionalPath(forward, backward, static_cast<uint32_t>(meeting));
+    return true;
+}
+
+// From the meeting cell back to each end. The meeting cell lies on a
+// shortest path, so both its distances are exact, and so is the distance of
+// the neighbour each was set from: a shorter one would make a shorter path.
+vector<MazeSolver::Point> MazeSolver::reconstructBidirectionalPath(const SearchSide& forward, const SearchSide& backward,
+                                                                  uint32_t meeting) const {
+    uint32_t toStart = forward.distance(meeting) - 1;
+    uint32_t toEnd = backward.distance(meeting) - 1;
+    vector<Point> path(static_cast<size_t>(toStart) + toEnd + 1);
+    auto walk = [&](const SearchSide& side, uint32_t g, size_t k, int step) {
+        Point current = indexToPoint(meeting);
+        path[k] = current;
+        for (; g > 0; --g) {
+            for (int i = 0; i < 4; ++i) {
+                Point previous{current.r + DR[i], current.c + DC[i]};
+                if (isValid(previous.r, previous.c) && side.distance(pointToIndex(previous)) == g) {
+                    current = previous;
+                    break;
                 }
             }
+            k += step;
+            path[k] = current;
         }
-    } // End while loop
+    };
+    walk(forward, toStart, toStart, -1);
+    walk(backward, toEnd, toStart, 1);
+    return path;
+}
+// --- End Bidirectional A* ---
 
-    return false; // No path found (openSet is empty)
+
+MazeSolver::SolveResult MazeSolver::solve(Algorithm algorithm, const Observer& observer) {
+    SolveResult result;
+
+    // Check start point validity before using it
+    if (startPoint.r < 0 || startPoint.r >= rows || startPoint.c < 0 || startPoint.c >= cols) {
+         cerr << Color::BOLD_RED << "Error: Invalid start point coordinates.\n" << Color::RESET;
+         return result;
+    }
+
+    if (algorithm == Algorithm::JPSPlus && jumpTable.empty()) {
+        if (static_cast<uint64_t>(rows) * cols > MAX_JUMP_TABLE_CELLS) {
+            cerr << Color::YELLOW << "Warning: The maze is too large for a jump table. Using JPS.\n" << Color::RESET;
+            algorithm = Algorithm::JPS;
+        } else {
+            auto tableStart = chrono::steady_clock::now();
+            buildJumpTable();
+            result.tableSeconds = chrono::duration<double>(chrono::steady_clock::now() - tableStart).count();
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    auto none = [](Point, uint32_t, uint32_t) {};
+    uint32_t pathCost = 0;
+    if (algorithm == Algorithm::AStar) {
+        result.found = observer ? searchAStar(observer, result, pathCost) : searchAStar(none, result, pathCost);
+        if (result.found) result.path = reconstructPath(pathCost);
+    } else if (algorithm == Algorithm::Bidirectional || algorithm == Algorithm::BidirectionalThreaded) {
+        bool threaded = algorithm == Algorithm::BidirectionalThreaded;
+        if (!observer) {
+            result.found = searchBidirectional(none, result, threaded);
+        } else {
+            mutex observerMutex; // The sides may report at once
+            auto serialized = [&](Point cell, uint32_t g, uint32_t f) {
+                lock_guard<mutex> lock(observerMutex);
+                observer(cell, g, f);
+            };
+            result.found = searchBidirectional(serialized, result, threaded);
+        }
+    } else {
+        bool useTable = algorithm == Algorithm::JPSPlus;
+        result.found = observer ? searchJPS(observer, result, pathCost, useTable) : searchJPS(none, result, pathCost, useTable);
+        if (result.found) result.path = reconstructJumpPath(pathCost);
+    }
+
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+
+// --- Modified solveAStar with Enhanced Visualization Output ---
+bool MazeSolver::solveAStar() {
+    // Use a copy for visualization steps
+    vector<string> displayGrid = grid;
+
+    Observer draw = [&](Point current, uint32_t g, uint32_t f) {
+        // Mark current node as visited on the temporary display grid
+        if (displayGrid[current.r][current.c] != START && displayGrid[current.r][current.c] != END) {
+             displayGrid[current.r][current.c] = VISITED;
+        }
+        clearScreen();
+        cout << Color::BOLD_YELLOW << "=== Maze Solver (A*) - Searching... ===" << Color::RESET << "\n";
+        displayMaze(displayGrid, true); // Show visited nodes during search
+
+        // Print status message
+        cout << " Exploring: (" << Color::CYAN << current.r << Color::RESET << ","
+             << Color::CYAN << current.c << Color::RESET << ") "
+             << " fCost=" << Color::YELLOW << f << Color::RESET
+             << " (g=" << g << ", h=" << f - g << ")" << "\n";
+        cout.flush(); // Ensure output is visible before sleep
+        this_thread::sleep_for(chrono::milliseconds(VISUALIZATION_DELAY_MS));
+    };
+
+    SolveResult result = solve(Algorithm::AStar, draw);
+    // Mark the member 'grid' with the solution path, except its end points
+    for (size_t i = 1; i + 1 < result.path.size(); ++i) {
+        grid[result.path[i].r][result.path[i].c] = SOLUTION_PATH;
+    }
+    return result.found;
 }
 // --- End solveAStar ---
 
@@ -2,22 +2,72 @@
 #define MAZESOLVER_H
 
 #include "game.h"
+#include "mazebitmap.h"
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
 #include <queue> // For priority_queue
-#include <map>   // For tracking costs and parents
 
 class MazeSolver : public Game {
 public:
-    // Constructor takes filename or uses a default maze
-    MazeSolver(const std::string& filename = "maze.txt");
+    // Constructor takes filename or uses a default maze (unless told not to)
+    MazeSolver(const std::string& filename = "maze.txt", bool useDefaultOnFailure = true);
     void play() override;
     std::string getName() const override { return "Maze Solver (A*)"; }
     virtual ~MazeSolver() = default;
 
+    // --- Engine interface for non-interactive use ---
+    struct Point { int r = -1, c = -1; };
+
+    // AStar expands cells one step apart. JPS (Jump Point Search) expands
+    // only the cells where a shortest path may have to turn, jumping along
+    // rows and columns in between: JPS finds them by scanning the wall
+    // bitmap a 64-cell word at a time, JPSPlus looks them up in a table of
+    // jump distances built once per maze (16 bytes per cell, so JPSPlus
+    // falls back to JPS above MAX_JUMP_TABLE_CELLS). Bidirectional runs A*
+    // from both ends at once until the two searches meet in the middle,
+    // BidirectionalThreaded with each side on its own thread. All return a
+    // shortest path, cell by cell.
+    enum class Algorithm { AStar, JPS, JPSPlus, Bidirectional, BidirectionalThreaded };
+    static const uint64_t MAX_JUMP_TABLE_CELLS = uint64_t(1) << 26;
+
+    struct SolveResult {
+        bool found = false;
+        std::vector<Point> path;  // Start to end, both included; length() steps
+        uint64_t expanded = 0;    // Cells taken off the open set (jump points for JPS)
+        uint64_t expandedForward = 0, expandedBackward = 0; // Bidirectional: by the side from the start / end
+        uint64_t heapPushes = 0;
+        uint64_t heapPops = 0;    // Stale entries included
+        double seconds = 0.0;
+        double tableSeconds = 0.0; // Building the JPSPlus table, if this solve did
+        size_t length() const { return path.empty() ? 0 : path.size() - 1; }
+    };
+
+    // Sees every expanded cell with its cost from the start (g) and
+    // estimated total (f). solve() without one runs a search loop with no
+    // hook in it at all; the interactive game draws its frames with one.
+    // The backward side of a bidirectional search reports its cost from the
+    // end; with threads, calls are serialized but the sides interleave.
+    using Observer = std::function<void(Point cell, uint32_t g, uint32_t f)>;
+
+    // A text maze, or a binary one (see MazeBitmap) which is mapped rather
+    // than read and has no text grid; false, with the reason on cerr, for
+    // an unusable file
+    bool loadMaze(const std::string& filename);
+    bool isLoaded() const { return walls.isLoaded(); }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    SolveResult solve(Algorithm algorithm = Algorithm::AStar, const Observer& observer = nullptr);
+
 private:
     // Maze representation & constants
-    std::vector<std::string> grid;
+    std::vector<std::string> grid; // Text mazes only; the search reads 'walls'
+    MazeBitmap walls;
     int rows = 0;
     int cols = 0;
     static const char WALL = '#';
@@ -28,38 +78,137 @@ private:
     static const char VISITED = '+'; // Mark visited during search
 
     // Start and end points
-    struct Point { int r = -1, c = -1; };
     Point startPoint, endPoint;
 
-    // A* specific data structures
-    struct Node {
-        Point pos;
-        int gCost = 0; // Cost from start
-        int hCost = 0; // Heuristic cost to end
-        int fCost() const { return gCost + hCost; } // Total estimated cost
-        Point parent;
+    // Search state shared by the algorithms
+    // Half a byte per cell, indexed by pointToIndex and kept between solves:
+    // (generation << 2) | tag once the cell is expanded (closed), the tag
+    // being gCost & 3 for A* (0 for JPS). Nibbles of an older generation
+    // are simply stale, so a new search only advances `generation` (1 to 3)
+    // and gets a fresh array once per cycle; it is calloc'd, so pages the
+    // search never reaches are never touched.
+    // No gCost or cameFrom arrays are needed: an entry's g is its f minus
+    // its h, and as neighbouring cells' distances differ by exactly 1, the
+    // step back from a closed cell at distance g goes to the closed
+    // neighbour at distance g - 1, the one tagged (g - 1) & 3. JPS logs
+    // the parent of each of its (far fewer) jump points instead.
+    std::unique_ptr<uint8_t[], void (*)(void*)> closedCells{nullptr, std::free};
+    size_t closedBytes = 0;
+    uint32_t generation = 0;
+    bool isClosed(uint32_t index) const { return (closedCells[index >> 1] >> (index & 1) * 4 & 0xC) == generation << 2; }
+    uint32_t closedTag(uint32_t index) const { return closedCells[index >> 1] >> (index & 1) * 4 & 3; }
+    void close(uint32_t index, uint32_t tag) {
+        uint8_t& pair = closedCells[index >> 1];
+        int shift = (index & 1) * 4;
+        pair = static_cast<uint8_t>((pair & ~(0xF << shift)) | (generation << 2 | (tag & 3)) << shift);
+    }
+    // Open set entries pack the f-cost above the h-cost, so integer order is
+    // f-cost order with ties going to the entry nearest the end; without
+    // that, an open area where every step towards the end keeps f equal is
+    // flooded. A cell is pushed again when another neighbour reaches it;
+    // only its first (cheapest) entry is expanded.
+    struct HeapEntry {
+        uint64_t key; // (fCost << 32) | hCost
+        uint32_t index;
+        uint32_t parent; // Position in jumpLog of the jump point the jump came from (JPS only)
+        bool operator>(const HeapEntry& other) const { return key > other.key; }
+    };
+    static const uint32_t NO_PARENT = UINT32_MAX;
+    static HeapEntry heapEntry(uint32_t gCost, uint32_t hCost, uint32_t index, uint32_t parent = NO_PARENT) {
+        return HeapEntry{(uint64_t(gCost + hCost) << 32) | hCost, index, parent};
+    }
 
-        // For priority queue ordering (min-heap based on fCost)
-        bool operator>(const Node& other) const {
-            return fCost() > other.fCost();
-        }
-         bool operator==(const Point& p) const { // Compare Node with Point
-            return pos.r == p.r && pos.c == p.c;
+    // --- Jump Point Search ---
+    // Of the shortest paths to a cell, JPS only follows the canonical one
+    // that takes every vertical step as early as the walls allow: a path
+    // that went sideways and then up could have gone up first, unless the
+    // cell above its previous cell is a wall (a forced turn). So after a
+    // horizontal step only the same direction is natural, and vertical ones
+    // only where forced; after a vertical step, that direction and both
+    // horizontal ones. A horizontal jump stops at a cell with a forced turn
+    // (or the end), a vertical jump at a cell where a horizontal one would
+    // stop somewhere.
+    // jumpTable holds per cell and direction the distance to that stop, or
+    // minus the number of open cells before a wall if there is none.
+    std::vector<int32_t> jumpTable; // Cleared by loadMaze
+    // Expanded jump points in order, each with its parent's position in
+    // the log, so the path is a chain of positions with no lookups. Walking
+    // back through closed cells is not enough here: a jump point may be
+    // closed with more than its distance when its shortest path passes it
+    // in mid-jump.
+    struct JumpPoint { uint32_t index, parent; };
+    std::vector<JumpPoint> jumpLog;
+    void buildJumpTable();
+    int scanRow(int r, int c, int dc) const; // Column of the next horizontal stop, -1 if a wall comes first
+    int jumpRow(Point from, int direction, bool useTable) const;    // Column of the successor, -1 if none
+    int jumpColumn(Point from, int direction, bool useTable) const; // Row of the successor, -1 if none
+    template <class Visit> bool searchJPS(Visit& visit, SolveResult& result, uint32_t& pathCost, bool useTable);
+    std::vector<Point> reconstructJumpPath(uint32_t pathCost) const; // From the last jump point logged
+    // --- End Jump Point Search ---
+
+    // --- Bidirectional A* ---
+    // Each side is A* towards the other end with its own distances: g + 1
+    // for every cell it has reached (0 if none), in blocks allocated as the
+    // side first reaches them, so memory follows the cells searched rather
+    // than the maze. A cell reached by both sides offers a path of gForward
+    // + gBackward; the best offer (mu) is kept in `best` with its cell.
+    // Plain f order would let both sides run most of the way, so cells come
+    // out in order of max(f, 2g) instead ("meet in the middle"): no side
+    // goes much past half the shortest path, and while mu is not shortest,
+    // some open cell on a shortest path has a priority no larger than the
+    // shortest length. The search stops, with mu proven shortest, once the
+    // smaller of the two sides' lowest priorities reaches mu or a side runs
+    // out of cells. Priorities never drop on a side, so the lowest one
+    // each side publishes in `frontier` is safe for the other to read late.
+    // With threads each side only writes its own distances, and they are
+    // only ever lowered to the length of a real path. A side writes a
+    // distance before reading the other's (sequentially consistent), so of
+    // two sides reaching the same cell at once at least one sees the other.
+    static const int DISTANCE_BLOCK_BITS = 12; // 4096 cells, 16 KB
+    struct alignas(64) SearchSide { // Aligned to keep each side's counters off the other's cache lines
+        std::unique_ptr<std::atomic<std::atomic<uint32_t>*>[]> blocks; // Null until reached
+        std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> openSet;
+        std::atomic<uint32_t> frontier{0};
+        Point target;
+        uint64_t expanded = 0, heapPushes = 0, heapPops = 0;
+        size_t blockCount = 0;
+
+        explicit SearchSide(uint64_t cells);
+        ~SearchSide();
+        // The owning side reads its own distances with `order` relaxed
+        uint32_t distance(uint32_t index, std::memory_order order = std::memory_order_seq_cst) const {
+            const std::atomic<uint32_t>* block = blocks[index >> DISTANCE_BLOCK_BITS].load(order);
+            return block ? block[index & ((1u << DISTANCE_BLOCK_BITS) - 1)].load(order) : 0;
         }
+        void setDistance(uint32_t index, uint32_t distance); // Owning side only
     };
+    static const uint64_t NO_MEETING = UINT64_MAX; // (mu << 32) | cell of `best` before any meeting
+    void startSide(SearchSide& side, Point from, Point target) const;
+    // Open set entries of a side: (max(f, 2g) << 32) | h, ties going to the
+    // entry nearest the other end
+    static HeapEntry meetingEntry(uint32_t gCost, uint32_t hCost, uint32_t index) {
+        return HeapEntry{(uint64_t(std::max(gCost + hCost, 2 * gCost)) << 32) | hCost, index, NO_PARENT};
+    }
+    // Expands one cell of `side`; false once the search is over
+    template <class Visit>
+    bool expandSide(SearchSide& side, const SearchSide& other, std::atomic<uint64_t>& best, Visit& visit);
+    template <class Visit> bool searchBidirectional(Visit& visit, SolveResult& result, bool threaded);
+    std::vector<Point> reconstructBidirectionalPath(const SearchSide& forward, const SearchSide& backward, uint32_t meeting) const;
+    // --- End Bidirectional A* ---
 
     // Helper methods
-    bool loadMaze(const std::string& filename);
     void displayMaze(bool showVisited = false) const; // Option to show search path
+    void displayMaze(const std::vector<std::string>& cells, bool showVisited) const;
     bool isValid(int r, int c) const;
     int calculateHeuristic(Point a, Point b) const; // Manhattan distance
-    bool solveAStar(); // Main A* algorithm
-    void reconstructPath(const std::map<int, Point>& cameFrom, Point current);
-    int pointToIndex(Point p) const { return p.r * cols + p.c; } // Helper to use Point as map key
-   // Old:
-// Point indexToPoint(int index) const { return {index / cols, index % cols}; } // Helper
-// New:
-Point indexToPoint(int index) const { return Point{index / cols, index % cols}; } // Helper
+    bool solveAStar(); // Animated solve for play(); marks the solution in 'grid'
+    // Main A* algorithm; the cost of the path found goes to `pathCost`
+    template <class Visit> bool searchAStar(Visit& visit, SolveResult& result, uint32_t& pathCost);
+    void prepareSearch(); // Sizes the arrays and opens a new generation
+    bool buildWalls(); // 'walls' from a text grid
+    std::vector<Point> reconstructPath(uint32_t pathCost) const;
+    uint32_t pointToIndex(Point p) const { return static_cast<uint32_t>(p.r) * cols + p.c; } // At most MazeBitmap::MAX_CELLS
+    Point indexToPoint(uint32_t index) const { return Point{static_cast<int>(index / cols), static_cast<int>(index % cols)}; }
 };
 
 #endif // MAZESOLVER_H
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include "mnkengine.h"
+#include <algorithm>
+
+using namespace std;
+
+const int MNKEngine::MAX_CELLS;
+const int MNKEngine::SMALL_BOARD;
+const int MNKEngine::BEAM;
+const int MNKEngine::WIN_SCORE;
+const int MNKEngine::WIN_THRESHOLD;
+
+namespace {
+    const int INF = MNKEngine::WIN_SCORE + 1;
+
+    // Forced results are stored relative to the node, not the root
+    int scoreToTable(int score, int ply) {
+        if (score > MNKEngine::WIN_THRESHOLD) return score + ply;
+        if (score < -MNKEngine::WIN_THRESHOLD) return score - ply;
+        return score;
+    }
+
+    int scoreFromTable(int score, int ply) {
+        if (score > MNKEngine::WIN_THRESHOLD) return score - ply;
+        if (score < -MNKEngine::WIN_THRESHOLD) return score + ply;
+        return score;
+    }
+
+    uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+}
+
+MNKEngine::MNKEngine(int rows, int cols, int winLength, size_t transpositionTableMB)
+    : numRows(rows), numCols(cols), k(winLength), cells(rows * cols), tt(transpositionTableMB) {
+    // --- Symmetries ---
+    // The first four exist on every board; transposing needs a square one
+    symmetries = rows == cols ? 8 : 4;
+    perm.assign(symmetries * cells, 0);
+    inverse.assign(symmetries * cells, 0);
+    const int R = rows - 1, C = cols - 1;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            const int images[8][2] = {
+                {r, c}, {r, C - c}, {R - r, c}, {R - r, C - c},
+                {c, r}, {c, R - r}, {C - c, r}, {C - c, R - r},
+            };
+            for (int s = 0; s < symmetries; ++s) {
+                int image = images[s][0] * cols + images[s][1];
+                perm[s * cells + r * cols + c] = image;
+                inverse[s * cells + image] = r * cols + c;
+            }
+        }
+    }
+
+    // --- Windows ---
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    vector<vector<int>> through(cells);
+    for (const auto& d : directions) {
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                int endR = r + (k - 1) * d[0], endC = c + (k - 1) * d[1];
+                if (endR < 0 || endR >= rows || endC < 0 || endC >= cols) continue;
+                Bitboard mask;
+                for (int i = 0; i < k; ++i) {
+                    int cell = (r + i * d[0]) * cols + c + i * d[1];
+                    mask.set(cell);
+                    through[cell].push_back(static_cast<int>(windowMasks.size()));
+                }
+                windowMasks.push_back(mask);
+            }
+        }
+    }
+    windowStart.assign(1, 0);
+    for (const auto& list : through) {
+        windowList.insert(windowList.end(), list.begin(), list.end());
+        windowStart.push_back(static_cast<int>(windowList.size()));
+    }
+
+    neighborStart.assign(1, 0);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            for (int nr = max(0, r - 2); nr <= min(R, r + 2); ++nr) {
+                for (int nc = max(0, c - 2); nc <= min(C, c + 2); ++nc) {
+                    if (nr != r || nc != c) neighbors.push_back(nr * cols + nc);
+                }
+            }
+            neighborStart.push_back(static_cast<int>(neighbors.size()));
+        }
+    }
+
+    // A window's value grows eightfold per stone, with the scale capped so
+    // that long lines (large k) stay far below WIN_THRESHOLD
+    weight.assign(k + 1, 0);
+    for (int n = 1; n <= k; ++n) weight[n] = 1 << max(0, 3 * (n - 1) - 3 * max(0, k - 5));
+
+    uint64_t seed = 0x6D6E6B2D656E6731ULL ^ (uint64_t(rows) << 32 | uint64_t(cols) << 16 | uint64_t(k));
+    pieceKeys.resize(2 * cells);
+    for (auto& key : pieceKeys) key = splitmix64(seed);
+    sideKey = splitmix64(seed);
+
+    counts[0].assign(windowMasks.size(), 0);
+    counts[1].assign(windowMasks.size(), 0);
+    nearCount.assign(cells, 0);
+    hashes.assign(symmetries, 0);
+}
+
+// --- Position state ---
+void MNKEngine::setPosition(const vector<int>& owner) {
+    stones[0] = stones[1] = Bitboard();
+    fill(counts[0].begin(), counts[0].end(), 0);
+    fill(counts[1].begin(), counts[1].end(), 0);
+    fill(nearCount.begin(), nearCount.end(), 0);
+    fill(hashes.begin(), hashes.end(), 0);
+    stoneCount = 0;
+    total = 0;
+    for (int cell = 0; cell < cells; ++cell) {
+        if (owner[cell] == 0 || owner[cell] == 1) makeMove(cell, owner[cell]);
+    }
+}
+
+bool MNKEngine::hasLine(int side) const {
+    for (const Bitboard& mask : windowMasks) {
+        if (stones[side].covers(mask)) return true;
+    }
+    return false;
+}
+
+int MNKEngine::windowScore(int w) const {
+    int own = counts[0][w], other = counts[1][w];
+    if (own != 0 && other != 0) return 0; // Blocked for both
+    return weight[own] - weight[other];
+}
+
+void MNKEngine::makeMove(int cell, int side) {
+    for (int i = windowStart[cell]; i < windowStart[cell + 1]; ++i) {
+        int w = windowList[i];
+        total -= windowScore(w);
+        ++counts[side][w];
+        total += windowScore(w);
+    }
+    for (int i = neighborStart[cell]; i < neighborStart[cell + 1]; ++i) ++nearCount[neighbors[i]];
+    for (int s = 0; s < symmetries; ++s) hashes[s] ^= pieceKeys[side * cells + perm[s * cells + cell]];
+    stones[side].set(cell);
+    ++stoneCount;
+}
+
+void MNKEngine::undoMove(int cell, int side) {
+    for (int i = windowStart[cell]; i < windowStart[cell + 1]; ++i) {
+        int w = windowList[i];
+        total -= windowScore(w);
+        --counts[side][w];
+        total += windowScore(w);
+    }
+    for (int i = neighborStart[cell]; i < neighborStart[cell + 1]; ++i) --nearCount[neighbors[i]];
+    for (int s = 0; s < symmetries; ++s) hashes[s] ^= pieceKeys[side * cells + perm[s * cells + cell]];
+    stones[side].reset(cell);
+    --stoneCount;
+}
+
+// Smallest hash over the symmetries, i.e. the hash of the canonical form;
+// `symmetry` is the one that maps the position onto it
+uint64_t MNKEngine::key(int sideToMove, int& symmetry) const {
+    symmetry = 0;
+    for (int s = 1; s < symmetries; ++s) {
+        if (hashes[s] < hashes[symmetry]) symmetry = s;
+    }
+    return hashes[symmetry] ^ (sideToMove ? sideKey : 0);
+}
+// --- End position state ---
+
+// --- Move generation ---
+void MNKEngine::generate(int side, Moves& moves) const {
+    const bool everyCell = cells <= SMALL_BOARD;
+    if (!everyCell && stoneCount == 0) {
+        moves.list[moves.count++] = {numRows / 2 * numCols + numCols / 2, 0}; // Open in the center
+        return;
+    }
+    // Cells near stones first; all of them only if those are all taken
+    for (int pass = everyCell ? 1 : 0; pass < 2 && moves.count == 0; ++pass) {
+        for (int cell = 0; cell < cells; ++cell) {
+            if (stones[0].test(cell) || stones[1].test(cell)) continue;
+            if (pass == 0 && nearCount[cell] == 0) continue;
+
+            // Attack: what the move adds to its windows; defense: what it takes away
+            int value = 0;
+            bool blocks = false;
+            for (int i = windowStart[cell]; i < windowStart[cell + 1]; ++i) {
+                int w = windowList[i];
+                int own = counts[side][w], other = counts[1 - side][w];
+                if (other == 0) {
+                    if (own == k - 1) moves.win = cell;
+                    value += weight[own + 1];
+                }
+                if (own == 0) {
+                    if (other == k - 1) blocks = true;
+                    value += weight[other + 1];
+                }
+            }
+            if (blocks && moves.blockCount < 2) moves.blocks[moves.blockCount++] = cell;
+            moves.list[moves.count++] = {cell, value};
+        }
+    }
+}
+
+void MNKEngine::order(Moves& moves, int ttCell) const {
+    for (int i = 0; i < moves.count; ++i) {
+        if (moves.list[i].cell == ttCell) moves.list[i].value = INF;
+    }
+    sort(moves.list, moves.list + moves.count,
+         [](const Candidate& a, const Candidate& b) { return a.value > b.value; });
+}
+// --- End move generation ---
+
+// --- Search ---
+bool MNKEngine::timeUp() {
+    if (chrono::steady_clock::now() >= deadline) stopped = true;
+    return stopped;
+}
+
+int MNKEngine::negamax(int side, int depth, int ply, int alpha, int beta, int& bestCell) {
+    ++nodes;
+    if ((nodes & 1023) == 0 && timeUp()) return 0;
+    if (stoneCount == cells) return 0; // Full board: draw
+
+    Moves moves;
+    generate(side, moves);
+    if (moves.win >= 0) {
+        bestCell = moves.win;
+        return WIN_SCORE - ply - 1;
+    }
+    if (moves.blockCount == 2) { // Two threats: blocking one loses to the other
+        bestCell = moves.blocks[0];
+        return -(WIN_SCORE - ply - 2);
+    }
+    if (depth == 0) return max(-WIN_THRESHOLD, min(WIN_THRESHOLD, evaluate(side)));
+
+    int symmetry = 0;
+    uint64_t hashKey = key(side, symmetry);
+    int ttCell = -1;
+    TranspositionTable::Entry entry;
+    if (tt.probe(hashKey, entry)) {
+        if (entry.bestMove >= 0 && entry.bestMove < cells) ttCell = inverse[symmetry * cells + entry.bestMove];
+        if (ply > 0 && entry.depth >= depth) {
+            int score = scoreFromTable(entry.score, ply);
+            if (entry.bound == TranspositionTable::BOUND_EXACT ||
+                (entry.bound == TranspositionTable::BOUND_LOWER && score >= beta) ||
+                (entry.bound == TranspositionTable::BOUND_UPPER && score <= alpha)) {
+                bestCell = ttCell;
+                return score;
+            }
+        }
+    }
+
+    if (moves.blockCount == 1) { // Anything else loses at once
+        moves.list[0] = {moves.blocks[0], 0};
+        moves.count = 1;
+    } else {
+        order(moves, ttCell);
+    }
+    int limit = ply > 0 && cells > SMALL_BOARD ? min(moves.count, BEAM) : moves.count;
+
+    const int alphaOrig = alpha;
+    int best = -INF, localBest = -1;
+    for (int i = 0; i < limit; ++i) {
+        int cell = moves.list[i].cell;
+        int childBest = -1;
+        makeMove(cell, side);
+        int score = -negamax(1 - side, depth - 1, ply + 1, -beta, -alpha, childBest);
+        undoMove(cell, side);
+        if (stopped) return 0;
+        if (score > best) {
+            best = score;
+            localBest = cell;
+        }
+        alpha = max(alpha, score);
+        if (alpha >= beta) break;
+    }
+
+    TranspositionTable::Bound bound = best <= alphaOrig ? TranspositionTable::BOUND_UPPER
+                                    : best >= beta ? TranspositionTable::BOUND_LOWER
+                                                   : TranspositionTable::BOUND_EXACT;
+    tt.store(hashKey, depth, scoreToTable(best, ply), bound, perm[symmetry * cells + localBest]);
+    bestCell = localBest;
+    return best;
+}
+
+MNKEngine::Result MNKEngine::search(const vector<int>& owner, int sideToMove, int timeBudgetMs, int maxDepth) {
+    auto start = chrono::steady_clock::now();
+    deadline = start + chrono::milliseconds(timeBudgetMs);
+    nodes = 0;
+    stopped = false;
+    setPosition(owner);
+
+    Result result;
+    if (stoneCount == cells || hasLine(0) || hasLine(1)) return result;
+
+    // Fallback in case not even the first iteration finishes
+    Moves moves;
+    generate(sideToMove, moves);
+    order(moves, -1);
+    result.cell = moves.win >= 0 ? moves.win : moves.blockCount > 0 ? moves.blocks[0] : moves.list[0].cell;
+
+    int limit = cells - stoneCount;
+    if (maxDepth > 0) limit = min(limit, maxDepth);
+    for (int depth = 1; depth <= limit; ++depth) {
+        int cell = -1;
+        int score = negamax(sideToMove, depth, 0, -INF, INF, cell);
+        if (stopped) break;
+        result.cell = cell;
+        result.score = score;
+        result.depth = depth;
+        if (score > WIN_THRESHOLD || score < -WIN_THRESHOLD) break; // Forced result found
+    }
+
+    result.nodes = nodes;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+// --- End search ---
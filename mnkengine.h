@@ -0,0 +1,128 @@
+#ifndef MNKENGINE_H
+#define MNKENGINE_H
+
+#include "transpositiontable.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Search engine for m,n,k-games: two players take turns marking cells of a
+// rows x cols board, and the first to get winLength in a row (horizontally,
+// vertically or diagonally) wins. Tic-Tac-Toe is 3,3,3; Gomoku is 15,15,5.
+//
+// Boards are 256-bit cell sets; every winLength-cell window of the board
+// has a precomputed mask, and each cell knows the windows through it. A move
+// updates per-window stone counts, from which the evaluator, the move
+// ordering and win detection are all read off incrementally.
+//
+// Search is iterative-deepening alpha-beta under a time and depth limit,
+// with a transposition table keyed by the canonical form of the position:
+// one Zobrist hash is kept per board symmetry (8 on square boards, 4 on
+// others) and the smallest is the key, so symmetric positions share entries.
+// Best moves are stored in the canonical orientation and mapped back.
+//
+// On boards larger than SMALL_BOARD cells only empty cells within two steps
+// of a stone are candidates, and inner nodes search the BEAM best-ordered
+// ones; wins, forced blocks and double threats are detected exactly.
+class MNKEngine {
+public:
+    static const int MAX_CELLS = 225;  // Up to 15 x 15; cell + 1 must fit the TT move field
+    static const int SMALL_BOARD = 25; // Up to 5 x 5 every empty cell is searched
+    static const int BEAM = 12;        // Moves searched below the root on larger boards
+
+    static const int WIN_SCORE = 1000000;             // Minus the plies to the win
+    static const int WIN_THRESHOLD = WIN_SCORE - 1000; // Scores beyond this are forced results
+
+    struct Result {
+        int cell = -1;        // row * cols + col, -1 if the board is full
+        int score = 0;        // For the side to move; beyond WIN_THRESHOLD a forced result
+        int depth = 0;        // Deepest completed iteration
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+    };
+
+    // rows * cols must not exceed MAX_CELLS, and 2 <= winLength <= max(rows, cols)
+    MNKEngine(int rows, int cols, int winLength, size_t transpositionTableMB = 16);
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int winLength() const { return k; }
+
+    // Best move for `sideToMove` (0 or 1). `owner` has rows * cols entries,
+    // row by row: -1 for an empty cell, else the side whose mark is there.
+    // The search stops after `timeBudgetMs` or at `maxDepth` plies (0 = no
+    // depth limit) and returns the result of the deepest finished iteration.
+    // A position where either side already has a line gets no move.
+    Result search(const std::vector<int>& owner, int sideToMove, int timeBudgetMs, int maxDepth = 0);
+
+    void newGame() { tt.clear(); }
+
+private:
+    struct Bitboard {
+        uint64_t words[4] = {};
+
+        void set(int cell) { words[cell >> 6] |= uint64_t(1) << (cell & 63); }
+        void reset(int cell) { words[cell >> 6] &= ~(uint64_t(1) << (cell & 63)); }
+        bool test(int cell) const { return (words[cell >> 6] >> (cell & 63)) & 1; }
+        bool covers(const Bitboard& m) const {
+            return (words[0] & m.words[0]) == m.words[0] && (words[1] & m.words[1]) == m.words[1] &&
+                   (words[2] & m.words[2]) == m.words[2] && (words[3] & m.words[3]) == m.words[3];
+        }
+    };
+
+    // Candidate move with its ordering value
+    struct Candidate {
+        int cell;
+        int value;
+    };
+
+    // Move generation summary of one node
+    struct Moves {
+        Candidate list[MAX_CELLS];
+        int count = 0;
+        int win = -1;        // A cell that completes a line for the side to move
+        int blocks[2] = {};  // Cells that complete a line for the opponent
+        int blockCount = 0;  // Distinct such cells, counted up to 2
+    };
+
+    void setPosition(const std::vector<int>& owner);
+    bool hasLine(int side) const;
+    void makeMove(int cell, int side);
+    void undoMove(int cell, int side);
+    uint64_t key(int sideToMove, int& symmetry) const;
+
+    int evaluate(int side) const { return side == 0 ? total : -total; }
+    int windowScore(int w) const; // Window w's share of total
+    void generate(int side, Moves& moves) const;
+    void order(Moves& moves, int ttCell) const;
+    int negamax(int side, int depth, int ply, int alpha, int beta, int& bestCell);
+    bool timeUp();
+
+    int numRows, numCols, k, cells;
+    int symmetries;                  // 8 on square boards, 4 otherwise
+    std::vector<int> perm;           // perm[s * cells + c]: cell c under symmetry s
+    std::vector<int> inverse;        // inverse[s * cells + perm[s * cells + c]] == c
+    std::vector<Bitboard> windowMasks;
+    std::vector<int> windowStart;    // Windows through cell c: windowList[windowStart[c] .. windowStart[c + 1])
+    std::vector<int> windowList;
+    std::vector<int> neighbors;      // Cells within two steps of c: same layout as windows
+    std::vector<int> neighborStart;
+    std::vector<int> weight;         // weight[n]: value of a window holding n stones of one side only
+    std::vector<uint64_t> pieceKeys; // pieceKeys[side * cells + c]
+    uint64_t sideKey = 0;
+
+    // Position state, updated by makeMove() / undoMove()
+    Bitboard stones[2];
+    std::vector<uint8_t> counts[2];  // Stones of each side per window
+    std::vector<int> nearCount;      // Stones within two steps, per cell
+    std::vector<uint64_t> hashes;    // One Zobrist hash per symmetry
+    int stoneCount = 0;
+    int total = 0;                   // Evaluation from side 0's point of view
+
+    TranspositionTable tt;
+    std::chrono::steady_clock::time_point deadline;
+    uint64_t nodes = 0;
+    bool stopped = false;
+};
+
+#endif // MNKENGINE_H
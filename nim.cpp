@@ -7,56 +7,214 @@
 #include <string>       // For string manipulation
 #include <thread>       // For this_thread::sleep_for
 #include <chrono>       // For chrono::milliseconds
+#include <algorithm>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>  // For the vectorized nim-sum
+#endif
 
 // Add this line after includes
 using namespace std;
 
-// --- Constructor and Game Logic (isValidMove, isGameOver) - unchanged ---
-Nim::Nim(vector<int> initial_piles) : piles(initial_piles) {
-    // Ensure no negative pile sizes initially
-    for(int& p : piles) {
-        if (p < 0) p = 0;
+// --- Definitions for static const members ---
+const size_t Nim::MAX_LISTED;
+const uint64_t Nim::MAX_DRAWN;
+const uint32_t Nim::NOT_INDEXED;
+// --- End definitions ---
+
+// --- Bit helpers ---
+namespace {
+    int highestBit(uint64_t x) { // x != 0
+    #if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(x);
+    #else
+        int i = 0;
+        while (x >>= 1) ++i;
+        return i;
+    #endif
     }
+
+    // XOR of n values, several vector lanes at a time. Two independent
+    // accumulators keep the loads from waiting on each other.
+    uint64_t xorReduce(const uint64_t* values, size_t n) {
+        size_t i = 0;
+        uint64_t result = 0;
+    #if defined(__AVX2__)
+        __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+        for (; i + 8 <= n; i += 8) {
+            a = _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+            b = _mm256_xor_si256(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4)));
+        }
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_xor_si256(a, b));
+        result = lanes[0] ^ lanes[1] ^ lanes[2] ^ lanes[3];
+    #elif defined(__SSE2__)
+        __m128i a = _mm_setzero_si128(), b = _mm_setzero_si128();
+        for (; i + 4 <= n; i += 4) {
+            a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+            b = _mm_xor_si128(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 2)));
+        }
+        alignas(16) uint64_t lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(a, b));
+        result = lanes[0] ^ lanes[1];
+    #endif
+        for (; i < n; ++i) result ^= values[i];
+        return result;
+    }
+}
+// --- End bit helpers ---
+
+
+// --- Constructor and Game Logic (isValidMove, isGameOver) ---
+Nim::Nim(vector<uint64_t> initial_piles) : Nim(initial_piles, {HeapGame()}) {}
+
+// Pile indices are stored as 32 bits, so up to about four billion piles
+Nim::Nim(vector<uint64_t> initial_piles, vector<HeapGame> pileGames, bool misere)
+    : piles(initial_piles), games(pileGames), misere(misere) {
      // Ensure there's at least one pile if input was empty
     if (piles.empty()) {
          piles = {3, 4, 5}; // Add a default if empty
     }
+    // One game for all piles unless there is exactly one per pile
+    if (games.size() != 1 && games.size() != piles.size()) {
+        games.assign(1, HeapGame());
+    }
+    buildIndex();
+}
+
+string Nim::getName() const {
+    if (allNim()) return misere ? "Misère Nim" : "Nim";
+    string name = games.size() == 1 ? "Subtraction Game " + games[0].describe() : "Sum of Games";
+    return misere ? "Misère " + name : name;
 }
 
-bool Nim::isValidMove(int pileIndex, int numToRemove) const {
-    return pileIndex >= 0 && pileIndex < piles.size() && // Valid pile index
-           numToRemove > 0 &&                           // Must remove at least one
-           numToRemove <= piles[pileIndex];             // Cannot remove more than available
+bool Nim::allNim() const {
+    for (const HeapGame& g : games) {
+        if (!g.isNim()) return false;
+    }
+    return true;
 }
 
-bool Nim::isGameOver() const {
-    // Game is over if all piles are empty (sum is 0)
-    // Check using accumulate or a simple loop
-    // return accumulate(piles.begin(), piles.end(), 0) == 0;
-    for (int count : piles) {
-        if (count > 0) return false; // Found a non-empty pile
+bool Nim::isValidMove(size_t pileIndex, uint64_t numToRemove) const {
+    return pileIndex < piles.size() &&                                   // Valid pile index
+           gameOf(pileIndex).canRemove(piles[pileIndex], numToRemove); // Allowed by the pile's game
+}
+
+void Nim::applyMove(size_t pileIndex, uint64_t numToRemove) {
+    uint64_t before = grundyOf(pileIndex);
+    countPile(pileIndex, -1);
+    piles[pileIndex] -= numToRemove;
+    countPile(pileIndex, +1);
+    uint64_t after = grundyOf(pileIndex);
+    if (before != after) {
+        unindexPile(pileIndex, before);
+        indexPile(pileIndex, after);
+        updateOr(pileIndex);
+        nimSum ^= before ^ after;
+    }
+    while (firstPlayable < piles.size() && gameOf(firstPlayable).smallestMove(piles[firstPlayable]) == 0) {
+        ++firstPlayable;
     }
-    return true; // All piles are empty
 }
 // --- End Game Logic ---
 
 
+// --- Position index ---
+void Nim::buildIndex() {
+    for (int b = 0; b < 64; ++b) {
+        if (!buckets[b].empty()) buckets[b].clear(); // Capacity is kept for the next position
+    }
+    slotOf.assign(piles.size(), NOT_INDEXED);
+    playable = nonEmpty = ones = large = 0;
+    for (size_t i = 0; i < piles.size(); ++i) {
+        countPile(i, +1);
+        indexPile(i, grundyOf(i));
+    }
+    for (leafBase = 1; leafBase < piles.size(); leafBase *= 2) {}
+    grundyOr.resize(leafBase);
+    for (size_t k = leafBase - 1; k >= 1; --k) grundyOr[k] = nodeOr(2 * k) | nodeOr(2 * k + 1);
+    nimSum = calculateNimSum();
+    firstPlayable = 0;
+    while (firstPlayable < piles.size() && gameOf(firstPlayable).smallestMove(piles[firstPlayable]) == 0) {
+        ++firstPlayable;
+    }
+}
+
+void Nim::indexPile(size_t pile, uint64_t grundy) {
+    if (grundy == 0) return; // Never the pile a winning move needs
+    int b = highestBit(grundy);
+    slotOf[pile] = static_cast<uint32_t>(buckets[b].size());
+    buckets[b].push_back(static_cast<uint32_t>(pile));
+}
+
+void Nim::unindexPile(size_t pile, uint64_t grundy) {
+    if (grundy == 0) return;
+    int b = highestBit(grundy);
+    // Swap with the bucket's last pile so removal is O(1)
+    uint32_t slot = slotOf[pile];
+    uint32_t last = buckets[b].back();
+    buckets[b][slot] = last;
+    slotOf[last] = slot;
+    buckets[b].pop_back();
+    slotOf[pile] = NOT_INDEXED;
+}
+
+void Nim::updateOr(size_t pile) {
+    for (size_t k = (leafBase + pile) / 2; k >= 1; k /= 2) {
+        uint64_t value = nodeOr(2 * k) | nodeOr(2 * k + 1);
+        if (value == grundyOr[k]) break; // Nor do the nodes above change
+        grundyOr[k] = value;
+    }
+}
+
+size_t Nim::pileWithBit(int bit) const {
+    size_t k = 1;
+    while (k < leafBase) k = (nodeOr(2 * k) >> bit) & 1 ? 2 * k : 2 * k + 1;
+    return k - leafBase;
+}
+
+void Nim::countPile(size_t pile, int delta) {
+    uint64_t size = piles[pile];
+    if (gameOf(pile).smallestMove(size) > 0) playable += delta;
+    if (size > 0) nonEmpty += delta;
+    if (size == 1) ones += delta;
+    else if (size > 1) large += delta;
+}
+// --- End position index ---
+
+
 // --- Modified displayPiles with better UI ---
+// Small games draw every item; large ones list counts, and a game with
+// more than MAX_LISTED piles shows totals and its first playable piles.
 void Nim::displayPiles() const {
     cout << "\n" << Color::WHITE << "Current Piles:" << Color::RESET << "\n";
     cout << Color::WHITE << "~~~~~~~~~~~~~~~~~" << Color::RESET << "\n"; // Separator
-    for (size_t i = 0; i < piles.size(); ++i) {
+    vector<size_t> shown;
+    if (piles.size() <= MAX_LISTED) {
+        for (size_t i = 0; i < piles.size(); ++i) shown.push_back(i);
+    } else {
+        cout << " " << Color::YELLOW << piles.size() << Color::RESET << " piles, " << Color::YELLOW << nonEmpty
+             << Color::RESET << " non-empty, " << Color::YELLOW << playable << Color::RESET << " playable";
+        for (size_t i = firstPlayable; i < piles.size() && shown.size() < MAX_LISTED; ++i) {
+            if (gameOf(i).smallestMove(piles[i]) > 0) shown.push_back(i);
+        }
+        cout << (shown.empty() ? "" : "; the first playable ones:") << "\n";
+    }
+    for (size_t i : shown) {
         // Display Pile index clearly
         cout << " Pile " << Color::CYAN << i << Color::RESET << ": ";
         // Display count in Yellow
-        cout << "[" << Color::YELLOW << piles[i] << Color::RESET << "] ";
-        // Display items using a character (e.g., 'O' or '|')
-        cout << "(";
-        for (int j = 0; j < piles[i]; ++j) {
-            cout << Color::GREEN << "O" << Color::RESET; // Green 'O' for items
-            if (j < piles[i] - 1) cout << " "; // Add space between items for clarity
+        cout << "[" << Color::YELLOW << piles[i] << Color::RESET << "]";
+        // Display items using a character (e.g., 'O' or '|') while they fit on a line
+        if (piles[i] <= MAX_DRAWN) {
+            cout << " (";
+            for (uint64_t j = 0; j < piles[i]; ++j) {
+                cout << Color::GREEN << "O" << Color::RESET; // Green 'O' for items
+                if (j < piles[i] - 1) cout << " "; // Add space between items for clarity
+            }
+            cout << ")";
         }
-        cout << ")\n";
+        if (games.size() > 1) cout << " " << Color::MAGENTA << gameOf(i).describe() << Color::RESET;
+        cout << "\n";
     }
     cout << Color::WHITE << "~~~~~~~~~~~~~~~~~" << Color::RESET << "\n\n"; // Separator
 }
@@ -64,30 +222,35 @@ void Nim::displayPiles() const {
 
 
 // --- Modified getPlayerMove with colored prompts and better validation feedback ---
-void Nim::getPlayerMove(int& pileIndex, int& numToRemove) {
+void Nim::getPlayerMove(size_t& pileIndex, uint64_t& numToRemove) {
      while (true) {
         cout << Color::BOLD_GREEN << "Your turn." << Color::RESET << "\n";
 
         // Get pile index using the utility function
-        pileIndex = getIntInput(" Enter pile index to remove from: ", 0, piles.size() - 1);
+        pileIndex = getUInt64Input(" Enter pile index to remove from: ", 0, piles.size() - 1);
 
-        // Check if the selected pile index is valid (should be guaranteed by getIntInput range)
-        // But add check for empty pile specifically
-        if (pileIndex < 0 || pileIndex >= piles.size()) {
-             cout << Color::BOLD_RED << " Error: Invalid pile index selected.\n" << Color::RESET; // Should not happen
-             continue;
-        }
+        // The range is checked by getUInt64Input; check for an empty pile specifically
         if (piles[pileIndex] == 0) {
             cout << Color::BOLD_RED << " Pile " << pileIndex << " is already empty. Please choose another pile.\n" << Color::RESET;
             continue; // Ask for input again
         }
+        if (gameOf(pileIndex).smallestMove(piles[pileIndex]) == 0) {
+            cout << Color::BOLD_RED << " Pile " << pileIndex << " is too small for any move of "
+                 << gameOf(pileIndex).describe() << ". Please choose another pile.\n" << Color::RESET;
+            continue;
+        }
 
         // Get number to remove, using pile size as the max limit
         string prompt = " Enter number of items to remove from pile " + Color::CYAN + to_string(pileIndex) +
                         Color::RESET + " (" + Color::YELLOW + "1-" + to_string(piles[pileIndex]) + Color::RESET + "): ";
-        numToRemove = getIntInput(prompt, 1, piles[pileIndex]);
+        numToRemove = getUInt64Input(prompt, 1, piles[pileIndex]);
 
-        // Validation is now handled by getIntInput, isValidMove check is redundant here
+        // getUInt64Input checks the range; subtraction games also restrict the amount
+        if (!isValidMove(pileIndex, numToRemove)) {
+            cout << Color::BOLD_RED << " Pile " << pileIndex << " only allows taking amounts in "
+                 << gameOf(pileIndex).describe() << ".\n" << Color::RESET;
+            continue;
+        }
         break; // Valid move parameters obtained
 
      } // End while loop
@@ -95,47 +258,103 @@ void Nim::getPlayerMove(int& pileIndex, int& numToRemove) {
 // --- End getPlayerMove ---
 
 
-// --- AI Nim-Sum Strategy (logic unchanged) ---
-int Nim::calculateNimSum() const {
-    int nimSum = 0;
-    for (int pileSize : piles) {
-        nimSum ^= pileSize; // Bitwise XOR
+// --- AI Nim-Sum Strategy ---
+// Sprague-Grundy: every pile counts as a Nim heap of its Grundy value, so
+// the XOR of those values decides the position as the nim-sum does in Nim.
+// applyMove() keeps nimSum current; this recomputes it from the piles.
+uint64_t Nim::calculateNimSum() const {
+    if (allNim()) return xorReduce(piles.data(), piles.size()); // Grundy value == size
+    uint64_t sum = 0;
+    for (size_t i = 0; i < piles.size(); ++i) {
+        sum ^= grundyOf(i); // Bitwise XOR
     }
-    return nimSum;
+    return sum;
 }
 
 Nim::Move Nim::findBestMove() {
-    int nimSum = calculateNimSum();
-    Move bestMove;
-    bestMove.pileIndex = -1; // Initialize to invalid
-    bestMove.numToRemove = -1;
+    if (misere && allNim()) return misereNimMove();
+
+    Move bestMove; // pileIndex -1: no move
 
     if (nimSum != 0) {
-        // Try to find a move to make nimSum zero (winning strategy)
-        for (size_t i = 0; i < piles.size(); ++i) {
-            if (piles[i] > 0) { // Only consider non-empty piles
-                int targetSize = piles[i] ^ nimSum;
-                if (targetSize < piles[i]) {
-                    bestMove.pileIndex = i;
-                    bestMove.numToRemove = piles[i] - targetSize;
-                    return bestMove; // Found optimal move
-                }
-            }
+        // A winning move makes nimSum zero: it lowers a pile whose value has
+        // the highest bit of nimSum set, and by the definition of the Grundy
+        // value a move reaches every smaller value. Bucket h holds only such
+        // piles; otherwise the OR tree leads to one in a higher bucket.
+        int h = highestBit(nimSum);
+        size_t i = buckets[h].empty() ? pileWithBit(h) : buckets[h][0];
+        uint64_t take = gameOf(i).moveTo(piles[i], grundyOf(i) ^ nimSum);
+        if (take > 0) {
+            bestMove.pileIndex = i;
+            bestMove.numToRemove = take;
+            return bestMove; // Found optimal move
         }
     }
 
     // If nimSum is 0 (losing position) or failed to find the optimal move (shouldn't happen)
-    // Make a default move: remove 1 from the first non-empty pile found.
-    for (size_t i = 0; i < piles.size(); ++i) {
-        if (piles[i] > 0) {
-            bestMove.pileIndex = i;
-            bestMove.numToRemove = 1;
-            break; // Take the first valid default move
-        }
+    // Make a default move: the smallest legal move from the first playable pile.
+    if (firstPlayable < piles.size()) {
+        bestMove.pileIndex = firstPlayable;
+        bestMove.numToRemove = gameOf(firstPlayable).smallestMove(piles[firstPlayable]);
     }
 
     return bestMove; // Return the best (or default) move found
 }
+
+// Misere Nim is played like normal Nim until the move that would leave no
+// pile larger than 1; that move leaves an odd number of single items instead,
+// so the opponent takes the last one. In Nim a pile's Grundy value is its
+// size, so single items make up bucket 0 and larger piles the rest.
+Nim::Move Nim::misereNimMove() const {
+    Move m;
+    if (large == 1) {
+        for (int b = 63; b >= 1; --b) {
+            if (buckets[b].empty()) continue;
+            m.pileIndex = buckets[b][0];
+            m.numToRemove = piles[m.pileIndex] - (ones % 2 == 1 ? 0 : 1);
+            return m;
+        }
+    }
+    if (large >= 2 && nimSum != 0) {
+        // Normal play while it leaves a pile larger than 1
+        int h = highestBit(nimSum);
+        m.pileIndex = buckets[h].empty() ? pileWithBit(h) : buckets[h][0];
+        m.numToRemove = piles[m.pileIndex] - (piles[m.pileIndex] ^ nimSum);
+        return m;
+    }
+    // Only single items left (won with an even count), or a lost position:
+    // take one item from the largest pile
+    for (int b = 63; b >= 0; --b) {
+        if (buckets[b].empty()) continue;
+        m.pileIndex = buckets[b][0];
+        m.numToRemove = 1;
+        break;
+    }
+    return m;
+}
+
+void Nim::setPiles(const vector<uint64_t>& sizes) {
+    piles = sizes;
+    if (games.size() != 1 && games.size() != piles.size()) games.assign(1, HeapGame());
+    buildIndex();
+}
+
+Nim::Analysis Nim::analyze() {
+    Analysis a;
+    if (isGameOver()) {
+        a.winning = misere; // The opponent made the last move
+        return a;
+    }
+    if (misere && allNim()) {
+        a.winning = large > 0 ? nimSum != 0 : ones % 2 == 0; // Single items: lost with an odd count
+    } else {
+        a.winning = nimSum != 0;
+    }
+    Move m = findBestMove();
+    a.pileIndex = m.pileIndex;
+    a.numToRemove = m.numToRemove;
+    return a;
+}
 // --- End AI ---
 
 
@@ -145,6 +364,8 @@ void Nim::play() {
     if (piles.empty() || isGameOver()) {
          cout << Color::BOLD_RED << "Starting Nim game with empty or invalid piles. Resetting to default {3, 4, 5}.\n" << Color::RESET;
          piles = {3, 4, 5}; // Use default piles
+         if (games.size() != 1) games.assign(1, HeapGame()); // Per-pile games no longer match
+         buildIndex();
          this_thread::sleep_for(chrono::seconds(1)); // Pause to see message
     }
 
@@ -154,7 +375,11 @@ void Nim::play() {
 
     while (!gameOver) {
         clearScreen();
-        cout << Color::BOLD_YELLOW << "=== Nim Game ===\n" << Color::RESET;
+        cout << Color::BOLD_YELLOW << "=== " << getName() << " ===\n" << Color::RESET;
+        if (games.size() == 1 && !games[0].isNim()) {
+            cout << "Each move takes an amount in " << Color::MAGENTA << games[0].describe() << Color::RESET << ".\n";
+        }
+        if (misere) cout << "Whoever takes the last item " << Color::BOLD_RED << "loses" << Color::RESET << ".\n";
         displayPiles(); // Show piles with enhanced UI
 
         string status;
@@ -162,12 +387,13 @@ void Nim::play() {
             // Human player's turn
             status = Color::BOLD_GREEN + string("Your turn (Human)") + Color::RESET;
             cout << status << "\n";
-            int pileIdx, numRemove;
+            size_t pileIdx;
+            uint64_t numRemove;
             getPlayerMove(pileIdx, numRemove); // Get validated move
 
             // Apply the move (with safety check)
-            if (pileIdx >= 0 && pileIdx < piles.size() && numRemove > 0 && numRemove <= piles[pileIdx]) {
-                 piles[pileIdx] -= numRemove;
+            if (isValidMove(pileIdx, numRemove)) {
+                 applyMove(pileIdx, numRemove);
             } else {
                  // This should ideally not happen due to getPlayerMove validation
                  cout << Color::BOLD_RED << "Internal Error: Invalid move parameters ["
@@ -186,8 +412,8 @@ void Nim::play() {
             if (aiMove.pileIndex != -1 && aiMove.numToRemove > 0) {
                  cout << " AI removes " << Color::YELLOW << aiMove.numToRemove << Color::RESET
                            << " from pile " << Color::CYAN << aiMove.pileIndex << Color::RESET << ".\n";
-                 if (aiMove.pileIndex >= 0 && aiMove.pileIndex < piles.size()) { // Safety check
-                    piles[aiMove.pileIndex] -= aiMove.numToRemove;
+                 if (isValidMove(aiMove.pileIndex, aiMove.numToRemove)) { // Safety check
+                    applyMove(aiMove.pileIndex, aiMove.numToRemove);
                  } else {
                      cout << Color::BOLD_RED << "Internal Error: AI chose invalid pile index " << aiMove.pileIndex << ".\n" << Color::RESET;
                  }
@@ -209,12 +435,12 @@ void Nim::play() {
         if (gameOver) {
             // Game just ended, display final result
             clearScreen();
-            cout << Color::BOLD_YELLOW << "=== Nim Game: Game Over ===\n" << Color::RESET;
-            displayPiles(); // Show final empty piles
-            // Winner is the player whose turn *it wasn't* when gameOver became true
-            if (currentPlayer == HUMAN_PLAYER) { // Human made the last move
+            cout << Color::BOLD_YELLOW << "=== " << getName() << ": Game Over ===\n" << Color::RESET;
+            displayPiles(); // Show final piles
+            // The last mover wins, or loses in misere play
+            if ((currentPlayer == HUMAN_PLAYER) != misere) { // Human made the winning last move
                 cout << Color::BOLD_GREEN << "*** Congratulations! You win! ***\n" << Color::RESET;
-            } else { // AI made the last move
+            } else { // AI made the winning last move
                  cout << Color::BOLD_RED << "*** AI Player wins! ***\n" << Color::RESET;
             }
         } else {
@@ -2,34 +2,95 @@
 #define NIM_H
 
 #include "game.h"
+#include "grundy.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
 class Nim : public Game {
 public:
     // Allow customizing pile setup
-    Nim(std::vector<int> initial_piles = {3, 4, 5});
+    Nim(std::vector<uint64_t> initial_piles = {3, 4, 5});
+    // Sum of heap games: pile i follows pileGames[i], or pileGames[0] if it
+    // is the only entry. In misere play whoever takes the last item loses;
+    // the AI plays that perfectly when every pile is Nim, and by the
+    // normal-play Grundy strategy otherwise.
+    Nim(std::vector<uint64_t> initial_piles, std::vector<HeapGame> pileGames, bool misere = false);
     void play() override;
-    std::string getName() const override { return "Nim"; }
+    std::string getName() const override;
     virtual ~Nim() = default;
 
+    // --- Engine interface for non-interactive use ---
+    struct Analysis {
+        bool winning = false;     // For the player to move (normal-play value for misere non-Nim games)
+        int64_t pileIndex = -1;   // AI move, -1 if no pile allows a move
+        uint64_t numToRemove = 0;
+    };
+
+    // New position under the same games and ending; per-pile games need the
+    // same pile count, otherwise every pile becomes Nim
+    void setPiles(const std::vector<uint64_t>& sizes);
+    Analysis analyze();
+
 private:
-    std::vector<int> piles;
+    std::vector<uint64_t> piles;
+    std::vector<HeapGame> games; // One for all piles, or one per pile
+    bool misere = false;
     static const char HUMAN_PLAYER = 'H'; // Just identifiers for turns
     static const char AI_PLAYER = 'A';
+    static const size_t MAX_LISTED = 16;  // displayPiles() summarizes more piles than this
+    static const uint64_t MAX_DRAWN = 20; // and draws no pile larger than this item by item
 
+    const HeapGame& gameOf(size_t pile) const { return games[games.size() == 1 ? 0 : pile]; }
+    uint64_t grundyOf(size_t pile) const { return gameOf(pile).grundy(piles[pile]); }
+    bool allNim() const;
     void displayPiles() const;
-    bool isValidMove(int pileIndex, int numToRemove) const;
-    bool isGameOver() const;
-    void getPlayerMove(int& pileIndex, int& numToRemove);
+    bool isValidMove(size_t pileIndex, uint64_t numToRemove) const;
+    bool isGameOver() const { return playable == 0; }
+    void getPlayerMove(size_t& pileIndex, uint64_t& numToRemove);
+    void applyMove(size_t pileIndex, uint64_t numToRemove); // Keeps the index below up to date
+
+    // --- Position index ---
+    // Maintained by applyMove() so the AI never scans the piles: piles are
+    // bucketed by the highest set bit of their Grundy value (piles of value
+    // 0 are left out). A winning move must lower a pile that has the
+    // nim-sum's highest bit set, which need not be in that bucket, so a
+    // binary tree over the piles also keeps the OR of the Grundy values
+    // below each node: one descent following that bit finds such a pile.
+    // grundyOr[k] covers node k, 1 <= k < leafBase, with children 2k and
+    // 2k + 1; node leafBase + i is pile i (0 past the last pile). That is
+    // 8 to 16 bytes per pile, and O(log piles) per move or lookup.
+    static const uint32_t NOT_INDEXED = UINT32_MAX;
+    uint64_t nimSum = 0;                 // XOR of all Grundy values
+    std::vector<uint32_t> buckets[64];
+    std::vector<uint32_t> slotOf;        // Position of each pile in its bucket
+    std::vector<uint64_t> grundyOr;
+    size_t leafBase = 1;                 // Piles rounded up to a power of two
+    size_t playable = 0;                 // Piles that allow a move
+    size_t firstPlayable = 0;            // No pile before this allows a move (piles never grow)
+    size_t nonEmpty = 0;
+    size_t ones = 0, large = 0;          // Piles of exactly 1 / more than 1 item, for misere Nim
+
+    void buildIndex();
+    void indexPile(size_t pile, uint64_t grundy);
+    void unindexPile(size_t pile, uint64_t grundy);
+    uint64_t nodeOr(size_t node) const {
+        if (node < leafBase) return grundyOr[node];
+        return node - leafBase < piles.size() ? grundyOf(node - leafBase) : 0;
+    }
+    void updateOr(size_t pile);          // After the pile's Grundy value changed
+    size_t pileWithBit(int bit) const;   // Some pile whose Grundy value has `bit` set; one must exist
+    void countPile(size_t pile, int delta); // playable, nonEmpty, ones and large
+    // --- End position index ---
 
     // AI using Nim-Sum strategy
     struct Move {
-        int pileIndex = -1;
-        int numToRemove = -1;
+        int64_t pileIndex = -1;
+        uint64_t numToRemove = 0;
     };
-    int calculateNimSum() const;
+    uint64_t calculateNimSum() const; // XOR of the piles' Grundy values from scratch (their sizes in Nim)
     Move findBestMove();
+    Move misereNimMove() const; // findBestMove() for misere play of plain Nim
 };
 
-#endif // NIM_H
\ No newline at end of file
+#endif // NIM_H
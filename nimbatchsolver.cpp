@@ -0,0 +1,196 @@
+#include "nimbatchsolver.h"
+#include "nim.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    // One block of the window; `index % window` picks the slot
+    struct Block {
+        vector<char> data; // Whole lines; its capacity is kept for the next block
+        size_t size = 0;
+        string output;
+        uint64_t positions = 0, errors = 0;
+        bool done = false;
+    };
+
+    void appendNumber(string& out, uint64_t value) {
+        char digits[20];
+        int n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value);
+        while (n > 0) out.push_back(digits[--n]);
+    }
+
+    // Reads pile sizes from [p, end); null on success, else the reason
+    const char* parsePiles(const char* p, const char* end, vector<uint64_t>& piles) {
+        piles.clear();
+        while (p < end) {
+            char c = *p;
+            if (c == ' ' || c == '\t' || c == ',') {
+                ++p;
+                continue;
+            }
+            if (c < '0' || c > '9') return "not a pile size";
+            uint64_t value = 0;
+            for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+                uint64_t digit = static_cast<uint64_t>(*p - '0');
+                if (value > (UINT64_MAX - digit) / 10) return "pile size exceeds 64 bits";
+                value = value * 10 + digit;
+            }
+            piles.push_back(value);
+        }
+        return nullptr;
+    }
+
+    void solveBlock(Nim& nim, vector<uint64_t>& piles, Block& block) {
+        const char* p = block.data.data();
+        const char* end = p + block.size;
+        block.positions = block.errors = 0;
+        while (p < end) {
+            const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (!eol) eol = end;
+            const char* lineEnd = eol > p && eol[-1] == '\r' ? eol - 1 : eol;
+            const char* error = parsePiles(p, lineEnd, piles);
+            p = eol + 1;
+            if (!error && piles.empty()) continue; // Blank line
+
+            ++block.positions;
+            if (error) {
+                ++block.errors;
+                block.output += "error ";
+                block.output += error;
+                block.output += '\n';
+                continue;
+            }
+            nim.setPiles(piles);
+            Nim::Analysis a = nim.analyze();
+            if (a.pileIndex < 0) {
+                block.output += a.winning ? "won\n" : "losing\n";
+            } else if (!a.winning) {
+                block.output += "losing\n";
+            } else {
+                appendNumber(block.output, static_cast<uint64_t>(a.pileIndex));
+                block.output += ' ';
+                appendNumber(block.output, a.numToRemove);
+                block.output += '\n';
+            }
+        }
+    }
+
+    // Fills `block` with the carried-over partial line and whole lines read
+    // after it; the new partial line goes back to `carry`. False at the end
+    // of the input, where the block takes everything that is left.
+    bool fillBlock(istream& in, Block& block, vector<char>& carry, size_t blockBytes, uint64_t& bytes) {
+        block.data.resize(max(blockBytes, 2 * carry.size()));
+        copy(carry.begin(), carry.end(), block.data.begin());
+        block.size = carry.size();
+        carry.clear();
+        for (;;) {
+            in.read(block.data.data() + block.size, static_cast<streamsize>(block.data.size() - block.size));
+            size_t got = static_cast<size_t>(in.gcount());
+            block.size += got;
+            bytes += got;
+            if (!in) return false;
+
+            auto last = find(make_reverse_iterator(block.data.begin() + block.size), block.data.rend(), '\n');
+            if (last != block.data.rend()) {
+                size_t lineEnd = static_cast<size_t>(block.data.rend() - last); // One past the newline
+                carry.assign(block.data.begin() + lineEnd, block.data.begin() + block.size);
+                block.size = lineEnd;
+                return true;
+            }
+            block.data.resize(2 * block.data.size()); // A line longer than the block
+        }
+    }
+}
+
+NimBatchSolver::Stats NimBatchSolver::run(istream& in, ostream& out) {
+    int workerCount = options.threads > 0 ? options.threads : max(1, static_cast<int>(thread::hardware_concurrency()));
+    const size_t window = options.window > 0 ? options.window : 4 * static_cast<size_t>(workerCount);
+    auto start = chrono::steady_clock::now();
+
+    vector<Block> blocks(window);
+    mutex m;
+    condition_variable workReady; // A block was read, or the input ended
+    condition_variable blockDone; // A worker finished a block
+    uint64_t readCount = 0, nextTask = 0, writeCount = 0;
+    bool endOfInput = false;
+    Stats stats;
+
+    auto work = [&] {
+        // The AI of the interactive game, without its play() loop
+        Nim nim(vector<uint64_t>{0}, vector<HeapGame>{HeapGame()}, options.misere);
+        vector<uint64_t> piles;
+
+        unique_lock<mutex> lock(m);
+        for (;;) {
+            workReady.wait(lock, [&] { return nextTask < readCount || endOfInput; });
+            if (nextTask == readCount) break; // Input ended and everything is taken
+            Block& block = blocks[nextTask++ % window];
+            lock.unlock();
+
+            // The reader leaves this slot alone until it has been written out
+            solveBlock(nim, piles, block);
+
+            lock.lock();
+            block.done = true;
+            blockDone.notify_one();
+        }
+    };
+
+    vector<thread> workers;
+    for (int i = 0; i < workerCount; ++i) workers.emplace_back(work);
+
+    // Reader and writer: keep the window full, write finished blocks in order
+    vector<char> carry;
+    unique_lock<mutex> lock(m);
+    for (;;) {
+        if (writeCount < readCount && blocks[writeCount % window].done) {
+            Block& block = blocks[writeCount % window];
+            lock.unlock();
+            out.write(block.output.data(), static_cast<streamsize>(block.output.size()));
+            lock.lock();
+            stats.positions += block.positions;
+            stats.errors += block.errors;
+            block.output.clear();
+            block.done = false;
+            ++writeCount;
+            continue;
+        }
+        if (endOfInput && writeCount == readCount) break;
+        if (!endOfInput && readCount - writeCount < window) {
+            Block& block = blocks[readCount % window];
+            lock.unlock();
+            bool more = fillBlock(in, block, carry, options.blockBytes, stats.bytes);
+            lock.lock();
+            if (block.size > 0) {
+                ++readCount;
+                workReady.notify_one();
+            }
+            if (!more) {
+                endOfInput = true;
+                workReady.notify_all();
+            }
+            continue;
+        }
+        blockDone.wait(lock);
+    }
+    lock.unlock();
+    for (thread& t : workers) t.join();
+    out.flush();
+
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return stats;
+}
@@ -0,0 +1,46 @@
+#ifndef NIMBATCHSOLVER_H
+#define NIMBATCHSOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Nim as a batch oracle over a stream of positions.
+//
+// Every input line is a position: pile sizes separated by spaces, tabs or
+// commas. Every output line is "pile count" (0-based pile, items to take)
+// for a winning move, "losing" when every move loses (including the empty
+// position in normal play), "won" for the empty position in misere play,
+// or "error <reason>". Output lines come in input order (blank input lines
+// are skipped).
+//
+// Input is read in blocks of `blockBytes` that end at a line boundary;
+// workers parse positions straight out of the block, without copying lines,
+// and each writes the block's answers into one buffer that the calling
+// thread writes out in block order. At most `window` blocks are in flight,
+// and their buffers are reused, so memory does not grow with the input.
+class NimBatchSolver {
+public:
+    struct Options {
+        int threads = 0;              // Workers, 0 = one per core
+        bool misere = false;          // Whoever takes the last item loses
+        size_t blockBytes = 1 << 20;  // Grown for a line that does not fit
+        size_t window = 0;            // Blocks in flight, 0 = 4 per worker
+    };
+
+    struct Stats {
+        uint64_t positions = 0; // Lines answered, errors included
+        uint64_t errors = 0;
+        uint64_t bytes = 0;
+        double seconds = 0.0;
+    };
+
+    explicit NimBatchSolver(const Options& options) : options(options) {}
+
+    Stats run(std::istream& in, std::ostream& out);
+
+private:
+    Options options;
+};
+
+#endif // NIMBATCHSOLVER_H
@@ -0,0 +1,87 @@
+#include "openingbook.h"
+#include "connectfourboard.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+namespace {
+    const char MAGIC[8] = {'C', '4', 'B', 'O', 'O', 'K', '1', '\0'};
+    const int KEY_SHIFT = 15;
+}
+
+const uint32_t OpeningBook::VERSION;
+const int OpeningBook::SCORE_LIMIT;
+
+bool OpeningBook::load(const string& path) {
+    entries = nullptr;
+    count = 0;
+    if (!file.open(path)) return false;
+
+    Header header;
+    if (file.size() < sizeof(Header)) { file.close(); return false; }
+    memcpy(&header, file.data(), sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        file.size() != sizeof(Header) + header.count * sizeof(uint64_t)) {
+        file.close();
+        return false;
+    }
+    // Entries start 8-byte aligned right after the header; no parsing needed
+    entries = reinterpret_cast<const uint64_t*>(file.data() + sizeof(Header));
+    count = static_cast<size_t>(header.count);
+    plies = static_cast<int>(header.maxPly);
+    return true;
+}
+
+uint64_t OpeningBook::canonicalKey(uint64_t current, uint64_t mask, bool& mirrored) {
+    uint64_t key = current + mask;
+    uint64_t mirrorKey = ConnectFourBoard::mirror(current) + ConnectFourBoard::mirror(mask);
+    mirrored = mirrorKey < key;
+    return mirrored ? mirrorKey : key;
+}
+
+bool OpeningBook::lookup(uint64_t current, uint64_t mask, int& col, int& score) const {
+    if (!entries) return false;
+    bool mirrored;
+    uint64_t key = canonicalKey(current, mask, mirrored);
+
+    const uint64_t* end = entries + count;
+    const uint64_t* it = lower_bound(entries, end, key << KEY_SHIFT);
+    if (it == end || (*it >> KEY_SHIFT) != key) return false;
+
+    int storedCol = static_cast<int>(*it & 7);
+    int raw = static_cast<int>((*it >> 3) & 0xFFF);
+    score = raw > SCORE_LIMIT ? raw - 4096 : raw; // Sign-extend 12 bits
+    col = mirrored ? ConnectFourBoard::COLS - 1 - storedCol : storedCol;
+    return true;
+}
+
+bool OpeningBook::write(const string& path, vector<Record> records, int maxPly, string& error) {
+    vector<uint64_t> packed;
+    packed.reserve(records.size());
+    for (const Record& r : records) {
+        int score = max(-SCORE_LIMIT, min(SCORE_LIMIT, r.score));
+        packed.push_back((r.key << KEY_SHIFT) | (uint64_t(score & 0xFFF) << 3) | uint64_t(r.col & 7));
+    }
+    sort(packed.begin(), packed.end());
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.maxPly = static_cast<uint32_t>(maxPly);
+    header.count = packed.size();
+
+    ofstream out(path, ios::binary);
+    if (!out) {
+        error = "cannot open '" + path + "' for writing";
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(packed.data()), packed.size() * sizeof(uint64_t));
+    if (!out) {
+        error = "write to '" + path + "' failed";
+        return false;
+    }
+    return true;
+}
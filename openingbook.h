@@ -0,0 +1,60 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "mappedfile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Precomputed ConnectFour opening moves, memory-mapped and binary-searched.
+//
+// Positions are keyed by (stones of the side to move + all stones), which is
+// unique per position, folded with its left/right mirror image: the smaller
+// of the two keys is stored, so each symmetric pair takes one entry.
+//
+// File layout (little-endian):
+//   Header { char magic[8] = "C4BOOK1"; uint32 version; uint32 maxPly; uint64 count; }
+//   uint64 entries[count], sorted ascending:
+//     bits 63..15  canonical key (49 bits)
+//     bits 14..3   score, 12-bit two's complement (clamped)
+//     bits  2..0   column in canonical orientation
+class OpeningBook {
+public:
+    struct Record {
+        uint64_t key = 0; // Canonical key
+        int col = -1;     // Canonical orientation
+        int score = 0;
+    };
+
+    bool load(const std::string& path); // False if missing or not a valid book
+    bool isLoaded() const { return entries != nullptr; }
+    size_t size() const { return count; }
+    int maxPly() const { return plies; }
+
+    // Book move for the side to move; `current` holds that side's stones
+    bool lookup(uint64_t current, uint64_t mask, int& col, int& score) const;
+
+    // Canonical key of a position; `mirrored` tells whether the mirror image was used
+    static uint64_t canonicalKey(uint64_t current, uint64_t mask, bool& mirrored);
+
+    // Sorts and writes records to a book file
+    static bool write(const std::string& path, std::vector<Record> records, int maxPly, std::string& error);
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t maxPly;
+        uint64_t count;
+    };
+
+    static const uint32_t VERSION = 1;
+    static const int SCORE_LIMIT = 2047;
+
+    MappedFile file;
+    const uint64_t* entries = nullptr;
+    size_t count = 0;
+    int plies = 0;
+};
+
+#endif // OPENINGBOOK_H
@@ -0,0 +1,304 @@
+#include "tablebase.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    const char MAGIC[8] = {'C', '4', 'T', 'B', 'A', 'S', 'E', '\0'};
+    const size_t IO_CHUNK_WORDS = size_t(1) << 20; // 8 MB per read/write
+
+    // Every way to put `stones` stones into the columns, as column heights
+    void heightVectors(int cols, int rows, int stones, vector<int>& current, vector<vector<int>>& out) {
+        if (static_cast<int>(current.size()) == cols) {
+            if (stones == 0) out.push_back(current);
+            return;
+        }
+        int remainingCols = cols - static_cast<int>(current.size()) - 1;
+        for (int h = max(0, stones - remainingCols * rows); h <= min(rows, stones); ++h) {
+            current.push_back(h);
+            heightVectors(cols, rows, stones - h, current, out);
+            current.pop_back();
+        }
+    }
+}
+
+template <class Board>
+const uint32_t BasicTablebase<Board>::VERSION;
+
+template <class Board>
+uint64_t BasicTablebase<Board>::index(Bits current, Bits mask) {
+    // current + mask + bottom row sets bit h of a column with h stones and
+    // keeps the side to move's stones below it; no column carries into the next
+    static constexpr Bits BOTTOM_ROW = [] {
+        Bits b = 0;
+        for (int c = 0; c < Board::COLS; ++c) b |= Board::bottomMask(c);
+        return b;
+    }();
+    const Bits key = current + mask + BOTTOM_ROW;
+    uint64_t idx = 0;
+    for (int c = Board::COLS - 1; c >= 0; --c) {
+        idx = idx * RADIX + static_cast<uint64_t>((key >> (c * Board::H1)) & RADIX) - 1;
+    }
+    return idx;
+}
+
+template <class Board>
+string BasicTablebase<Board>::defaultPath() {
+    string name = Board::WIN_LENGTH == 4 ? "connectfour" : Board::WIN_LENGTH == 5 ? "connectfive"
+                : "connect" + to_string(Board::WIN_LENGTH);
+    return name + "-" + to_string(Board::COLS) + "x" + to_string(Board::ROWS) + ".tb";
+}
+
+template <class Board>
+auto BasicTablebase<Board>::decode(uint64_t c) -> Value {
+    Value v;
+    if (c == DRAW) return v; // Distance filled in by the caller
+    v.distance = static_cast<int>(c - 1);
+    v.outcome = v.distance % 2 ? 1 : -1;
+    return v;
+}
+
+template <class Board>
+bool BasicTablebase<Board>::load(const string& path) {
+    words = nullptr;
+    lowest = CELLS + 1;
+    if (!SUPPORTED || !file.open(path)) return false;
+
+    Header header;
+    if (file.size() < sizeof(Header)) { file.close(); return false; }
+    memcpy(&header, file.data(), sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.rows != Board::ROWS || header.cols != Board::COLS || header.winLength != Board::WIN_LENGTH ||
+        header.valueBits != VALUE_BITS || header.positions != POSITIONS || header.lowestLayer > CELLS ||
+        file.size() != sizeof(Header) + wordCount() * sizeof(uint64_t)) {
+        file.close();
+        return false;
+    }
+    words = reinterpret_cast<const uint64_t*>(file.data() + sizeof(Header));
+    lowest = static_cast<int>(header.lowestLayer);
+    return true;
+}
+
+template <class Board>
+bool BasicTablebase<Board>::probe(const Board& b, int sideToMove, Value& value) const {
+    if (!words || b.moveCount() < lowest) return false;
+    uint64_t c = code(words, index(b, sideToMove));
+    if (c == 0) return false;
+    value = decode(c);
+    if (c == DRAW) value.distance = CELLS - b.moveCount();
+    return true;
+}
+
+template <class Board>
+bool BasicTablebase<Board>::bestMove(const Board& b, int sideToMove, int& col, Value& value) const {
+    if (!words || b.moveCount() < lowest) return false;
+    col = -1;
+    auto better = [](const Value& x, const Value& y) { // x preferred over y
+        if (x.outcome != y.outcome) return x.outcome > y.outcome;
+        return x.outcome > 0 ? x.distance < y.distance : x.distance > y.distance;
+    };
+    for (int c = 0; c < Board::COLS; ++c) {
+        if (!b.canPlay(c)) continue;
+        Value v;
+        if (b.isWinningMove(c, sideToMove)) {
+            v.outcome = 1;
+            v.distance = 1;
+        } else {
+            Board child = b;
+            child.play(c, sideToMove);
+            Value reply;
+            if (!probe(child, 1 - sideToMove, reply)) return false;
+            v.outcome = -reply.outcome;
+            v.distance = reply.distance + 1;
+        }
+        if (col == -1 || better(v, value)) {
+            col = c;
+            value = v;
+        }
+    }
+    return col != -1;
+}
+
+// --- Generation ---
+template <class Board>
+bool BasicTablebase<Board>::generate(const string& path, int threads, int minStones, ostream& log, string& error) {
+    if (!SUPPORTED) {
+        error = "this board has too many positions for a tablebase";
+        return false;
+    }
+    if (threads <= 0) threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    minStones = max(0, min(CELLS, minStones));
+    const uint64_t wordsTotal = wordCount();
+
+    // Values are OR-ed in by many threads; each position is written once
+    unique_ptr<atomic<uint64_t>[]> table(new atomic<uint64_t>[wordsTotal]());
+    vector<uint64_t> chunk;
+
+    Header header;
+    fstream f(path, ios::in | ios::out | ios::binary);
+    if (f) { // Resume from the last finished layer
+        f.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!f || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+            header.rows != Board::ROWS || header.cols != Board::COLS || header.winLength != Board::WIN_LENGTH ||
+            header.valueBits != VALUE_BITS || header.positions != POSITIONS || header.lowestLayer > CELLS + 1) {
+            error = "'" + path + "' exists but is not a tablebase for this board";
+            return false;
+        }
+        for (uint64_t w = 0; w < wordsTotal; w += chunk.size()) {
+            chunk.resize(static_cast<size_t>(min<uint64_t>(IO_CHUNK_WORDS, wordsTotal - w)));
+            if (!f.read(reinterpret_cast<char*>(chunk.data()), chunk.size() * sizeof(uint64_t))) {
+                error = "'" + path + "' is truncated";
+                return false;
+            }
+            for (size_t i = 0; i < chunk.size(); ++i) table[w + i].store(chunk[i], memory_order_relaxed);
+        }
+        log << "Resuming " << path << " below layer " << header.lowestLayer << "\n";
+    } else { // New table: header and zeroed values
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.rows = Board::ROWS;
+        header.cols = Board::COLS;
+        header.winLength = Board::WIN_LENGTH;
+        header.valueBits = VALUE_BITS;
+        header.lowestLayer = CELLS + 1;
+        header.targetLayer = static_cast<uint32_t>(minStones);
+        header.positions = POSITIONS;
+        ofstream out(path, ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        chunk.assign(IO_CHUNK_WORDS, 0);
+        for (uint64_t w = 0; w < wordsTotal; w += IO_CHUNK_WORDS) {
+            out.write(reinterpret_cast<const char*>(chunk.data()),
+                      min<uint64_t>(IO_CHUNK_WORDS, wordsTotal - w) * sizeof(uint64_t));
+        }
+        out.close();
+        f.open(path, ios::in | ios::out | ios::binary);
+        if (!out || !f) {
+            error = "cannot create '" + path + "'";
+            return false;
+        }
+    }
+    header.targetLayer = static_cast<uint32_t>(min<uint32_t>(header.targetLayer, minStones));
+
+    auto valueAt = [&](uint64_t i) {
+        return (table[i / PER_WORD].load(memory_order_relaxed) >> (i % PER_WORD * VALUE_BITS)) &
+               ((uint64_t(1) << VALUE_BITS) - 1);
+    };
+
+    for (int layer = static_cast<int>(header.lowestLayer) - 1; layer >= minStones; --layer) {
+        auto start = chrono::steady_clock::now();
+        vector<vector<int>> shapes;
+        vector<int> current;
+        heightVectors(Board::COLS, Board::ROWS, layer, current, shapes);
+
+        // Threads take whole column-height shapes; within a shape every way
+        // to color `layer / 2` of the stones as the side to move's is solved
+        atomic<size_t> nextShape{0};
+        atomic<uint64_t> solved{0};
+        auto work = [&] {
+            const int moverStones = layer / 2; // The side to move never has more stones
+            uint64_t count = 0;
+            Bits cells[CELLS];
+            for (size_t s; (s = nextShape++) < shapes.size();) {
+                Bits mask = 0;
+                int n = 0;
+                for (int c = 0; c < Board::COLS; ++c) {
+                    for (int r = 0; r < shapes[s][c]; ++r) {
+                        cells[n++] = Board::cellMask(r, c);
+                        mask |= Board::cellMask(r, c);
+                    }
+                }
+                const uint64_t limit = uint64_t(1) << n;
+                for (uint64_t subset = (uint64_t(1) << moverStones) - 1; subset < limit;) {
+                    Bits mover = 0;
+                    for (uint64_t m = subset; m; m &= m - 1) mover |= cells[c4bits::lowestBit(m)];
+                    Bits opponent = mask ^ mover;
+
+                    uint64_t value;
+                    if (Board::alignment(opponent)) {
+                        value = 1; // The previous move won
+                    } else if (Board::alignment(mover)) {
+                        value = 0; // Unreachable
+                    } else if (layer == CELLS) {
+                        value = DRAW;
+                    } else {
+                        int bestWin = CELLS + 1, worstLoss = -1;
+                        bool draw = false;
+                        for (int c = 0; c < Board::COLS; ++c) {
+                            if (mask & Board::topMask(c)) continue;
+                            Bits move = (mask + Board::bottomMask(c)) & Board::columnMask(c);
+                            if (Board::alignment(mover | move)) {
+                                bestWin = 1;
+                                break;
+                            }
+                            uint64_t child = valueAt(index(opponent, mask | move));
+                            if (child == DRAW) {
+                                draw = true;
+                            } else if (child != 0) {
+                                int d = static_cast<int>(child - 1);
+                                if (d % 2) worstLoss = max(worstLoss, d + 1); // Opponent wins
+                                else bestWin = min(bestWin, d + 1);
+                            }
+                        }
+                        value = bestWin <= CELLS ? 1 + bestWin : draw ? DRAW : 1 + worstLoss;
+                    }
+                    if (value) {
+                        uint64_t i = index(mover, mask);
+                        table[i / PER_WORD].fetch_or(value << (i % PER_WORD * VALUE_BITS), memory_order_relaxed);
+                        ++count;
+                    }
+
+                    if (subset == 0) break; // The empty set has no successor
+                    uint64_t low = subset & (~subset + 1); // Next subset of the same size (Gosper)
+                    uint64_t ripple = subset + low;
+                    subset = (((ripple ^ subset) >> 2) / low) | ripple;
+                }
+            }
+            solved += count;
+        };
+        vector<thread> pool;
+        for (int i = 1; i < threads; ++i) pool.emplace_back(work);
+        work();
+        for (thread& t : pool) t.join();
+
+        // Checkpoint: values first, then the header that declares them finished
+        f.seekp(sizeof(Header));
+        chunk.resize(IO_CHUNK_WORDS);
+        for (uint64_t w = 0; w < wordsTotal; w += IO_CHUNK_WORDS) {
+            size_t n = static_cast<size_t>(min<uint64_t>(IO_CHUNK_WORDS, wordsTotal - w));
+            for (size_t i = 0; i < n; ++i) chunk[i] = table[w + i].load(memory_order_relaxed);
+            f.write(reinterpret_cast<const char*>(chunk.data()), n * sizeof(uint64_t));
+        }
+        f.flush();
+        header.lowestLayer = static_cast<uint32_t>(layer);
+        f.seekp(0);
+        f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        f.flush();
+        if (!f) {
+            error = "write to '" + path + "' failed";
+            return false;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        log << "  layer " << layer << ": " << solved << " positions in " << seconds << " s\n";
+    }
+    return true;
+}
+// --- End generation ---
+
+// --- Explicit instantiations (one per ConnectFour geometry, see connectfour.h) ---
+template class BasicTablebase<BasicConnectFourBoard<6, 7, 4>>;
+template class BasicTablebase<BasicConnectFourBoard<7, 8, 4>>;
+#if defined(__SIZEOF_INT128__)
+template class BasicTablebase<BasicConnectFourBoard<7, 9, 4>>;
+#endif
+template class BasicTablebase<BasicConnectFourBoard<6, 9, 5>>;
+template class BasicTablebase<BasicConnectFourBoard<4, 5, 4>>;
+template class BasicTablebase<BasicConnectFourBoard<5, 5, 4>>;
+// --- End explicit instantiations ---
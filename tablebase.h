@@ -0,0 +1,119 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "connectfourboard.h"
+#include "mappedfile.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Endgame tablebase: the exact value of every position of a small Connect
+// Four board, built by retrograde analysis and probed without search.
+//
+// Index: a column with h stones is coded as 2^h + (stones of the side to
+// move in it), minus one, which numbers its 2^(ROWS+1) - 1 possible
+// contents densely; the position index is these codes in base RADIX, one
+// digit per column. Every position has exactly one index, so there are no
+// keys or collisions. The side to move follows from the stone count, so
+// the table is the same for both colors.
+//
+// Value: plies to the end of the game with perfect play (win for the side
+// to move if odd, loss if even) or a draw, in VALUE_BITS bits per position,
+// packed without straddling 64-bit words:
+//   0             not a legal position (the side to move already has a line)
+//   1 + distance  decided, distance 0 meaning the previous move won
+//   CELLS + 2     draw
+//
+// Generation runs layer by layer from the full board down: a position's
+// children have one more stone, so each layer needs only the one above and
+// its positions can be solved by any number of threads at once. The table
+// file is written after every layer, and generation resumes from the last
+// finished layer. A table can stop at a minimum stone count; positions with
+// fewer stones are then left to the search.
+//
+// File layout (little-endian, mapped read-only by load()):
+//   Header { char magic[8] = "C4TBASE"; uint32 version; uint8 rows, cols,
+//            winLength, valueBits; uint32 lowestLayer; uint32 targetLayer;
+//            uint64 positions; }
+//   uint64 words[], VALUE_BITS-bit values from the low bits up
+template <class Board>
+class BasicTablebase {
+public:
+    using Bits = typename Board::Bits;
+
+    static constexpr int CELLS = Board::ROWS * Board::COLS;
+    static constexpr uint64_t RADIX = (uint64_t(1) << Board::H1) - 1; // Contents of one column
+
+    // At the 5 or 6 VALUE_BITS of boards this large, packed 12 or 10 to a
+    // word, 2^36 positions take 43 to 51 GiB
+    static constexpr uint64_t MAX_POSITIONS = uint64_t(1) << 36;
+
+    // Positions in the index, 0 if the board is too large to tabulate
+    static constexpr uint64_t POSITIONS = [] {
+        uint64_t n = 1;
+        for (int c = 0; c < Board::COLS; ++c) {
+            if (n > MAX_POSITIONS / RADIX) return uint64_t(0);
+            n *= RADIX;
+        }
+        return n;
+    }();
+    static constexpr bool SUPPORTED = POSITIONS != 0;
+
+    static constexpr int VALUE_BITS = [] {
+        int bits = 1;
+        while ((1 << bits) <= CELLS + 2) ++bits;
+        return bits;
+    }();
+    static constexpr int PER_WORD = 64 / VALUE_BITS;
+
+    // Exact value for the side to move
+    struct Value {
+        int outcome = 0;  // +1 win, 0 draw, -1 loss
+        int distance = 0; // Plies to the end of the game
+    };
+
+    static uint64_t index(Bits current, Bits mask);
+    static uint64_t index(const Board& b, int sideToMove) { return index(b.sideMask(sideToMove), b.occupiedMask()); }
+
+    // Default file name for this geometry, e.g. "connectfour-5x4.tb"
+    static std::string defaultPath();
+
+    bool load(const std::string& path); // False if missing or not a table for this geometry
+    bool isLoaded() const { return words != nullptr; }
+    int lowestLayer() const { return lowest; } // Fewest stones covered
+
+    // False if not loaded or the position has too few stones
+    bool probe(const Board& b, int sideToMove, Value& value) const;
+    // Best move by table values (fastest win, else draw, else slowest loss)
+    bool bestMove(const Board& b, int sideToMove, int& col, Value& value) const;
+
+    // Builds or resumes `path` down to positions with `minStones` stones;
+    // progress goes to `log`
+    static bool generate(const std::string& path, int threads, int minStones, std::ostream& log, std::string& error);
+
+private:
+    static constexpr uint64_t DRAW = CELLS + 2;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint8_t rows, cols, winLength, valueBits;
+        uint32_t lowestLayer; // Fewest stones of a finished layer, CELLS + 1 if none
+        uint32_t targetLayer; // Layer generation stops at
+        uint64_t positions;
+    };
+
+    static const uint32_t VERSION = 1;
+
+    static uint64_t wordCount() { return (POSITIONS + PER_WORD - 1) / PER_WORD; }
+    static uint64_t code(const uint64_t* table, uint64_t i) {
+        return (table[i / PER_WORD] >> (i % PER_WORD * VALUE_BITS)) & ((uint64_t(1) << VALUE_BITS) - 1);
+    }
+    static Value decode(uint64_t c);
+
+    MappedFile file;
+    const uint64_t* words = nullptr;
+    int lowest = CELLS + 1;
+};
+
+#endif // TABLEBASE_H
@@ -17,15 +17,25 @@ const char TicTacToe::HUMAN_PLAYER;
 const char TicTacToe::AI_PLAYER;
 const char TicTacToe::EMPTY_SLOT;
 const int TicTacToe::BOARD_SIZE;
+const int TicTacToe::THINK_TIME_MS;
 // --- End definitions ---
 
-TicTacToe::TicTacToe() {
-    // Constructor remains simple, board initialized in play()
+TicTacToe::TicTacToe(int rows, int cols, int winLength) : rows(rows), cols(cols), winLength(winLength) {
+    // Board initialized in play(); the classic game needs no engine
+    if (!isClassic()) engine = make_unique<MNKEngine>(rows, cols, winLength);
+}
+
+string TicTacToe::getName() const {
+    if (isClassic()) return "Tic-Tac-Toe";
+    string size = to_string(rows) + "x" + to_string(cols);
+    if (winLength == 5) return "Gomoku " + size;
+    return "Tic-Tac-Toe " + size + " (" + to_string(winLength) + " in a row)";
 }
 
 void TicTacToe::initializeBoard() {
     // Use vector's assign method for clean initialization
-    board.assign(BOARD_SIZE, vector<char>(BOARD_SIZE, EMPTY_SLOT));
+    board.assign(rows, vector<char>(cols, EMPTY_SLOT));
+    if (engine) engine->newGame();
 }
 
 // --- Modified displayBoard with UI enhancements ---
@@ -33,7 +43,7 @@ void TicTacToe::displayBoard() const {
     cout << "\n";
     // Print column numbers centered above the board
     cout << "   "; // Initial padding to align with board lines
-    for (int j = 0; j < BOARD_SIZE; ++j) {
+    for (int j = 0; j < cols; ++j) {
         // setw(2) ensures consistent spacing for numbers
         cout << Color::WHITE << setw(2) << j << Color::RESET << " ";
     }
@@ -41,20 +51,20 @@ void TicTacToe::displayBoard() const {
 
     // Top border of the board using box-drawing characters
     cout << "  " << Color::WHITE << "╔"; // Top-left corner
-    for (int j = 0; j < BOARD_SIZE; ++j) {
+    for (int j = 0; j < cols; ++j) {
         cout << "═══"; // Horizontal line segment for a cell
-        cout << (j < BOARD_SIZE - 1 ? "╦" : "╗"); // T-connector or Top-right corner
+        cout << (j < cols - 1 ? "╦" : "╗"); // T-connector or Top-right corner
     }
     cout << Color::RESET << "\n";
 
     // Iterate through each row of the board
-    for (int i = 0; i < BOARD_SIZE; ++i) {
+    for (int i = 0; i < rows; ++i) {
         // Print row number at the start of the line
         cout << Color::WHITE << setw(2) << i << Color::RESET << " ";
         cout << Color::WHITE << "║" << Color::RESET; // Left vertical border
 
         // Iterate through columns in the current row
-        for (int j = 0; j < BOARD_SIZE; ++j) {
+        for (int j = 0; j < cols; ++j) {
             cout << " "; // Padding inside the cell
             char player = board[i][j]; // Get the character in the current cell
 
@@ -71,11 +81,11 @@ void TicTacToe::displayBoard() const {
         cout << "\n"; // End of the row
 
         // Print separator line between rows (unless it's the last row)
-        if (i < BOARD_SIZE - 1) {
+        if (i < rows - 1) {
             cout << "  " << Color::WHITE << "╠"; // Left T-connector
-            for (int j = 0; j < BOARD_SIZE; ++j) {
+            for (int j = 0; j < cols; ++j) {
                 cout << "═══"; // Horizontal line segment
-                cout << (j < BOARD_SIZE - 1 ? "╬" : "╣"); // Cross-connector or Right T-connector
+                cout << (j < cols - 1 ? "╬" : "╣"); // Cross-connector or Right T-connector
             }
              cout << Color::RESET << "\n";
         }
@@ -83,33 +93,43 @@ void TicTacToe::displayBoard() const {
 
     // Bottom border of the board
     cout << "  " << Color::WHITE << "╚"; // Bottom-left corner
-    for (int j = 0; j < BOARD_SIZE; ++j) {
+    for (int j = 0; j < cols; ++j) {
         cout << "═══"; // Horizontal line segment
-        cout << (j < BOARD_SIZE - 1 ? "╩" : "╝"); // Bottom T-connector or Bottom-right corner
+        cout << (j < cols - 1 ? "╩" : "╝"); // Bottom T-connector or Bottom-right corner
     }
     cout << Color::RESET << "\n\n"; // Add extra newlines for spacing
 }
 // --- End displayBoard ---
 
 
-// --- isValidMove, checkWin, isBoardFull, checkGameOver (logic unchanged) ---
+// --- isValidMove, checkWin, isBoardFull, checkGameOver ---
 bool TicTacToe::isValidMove(int row, int col) const {
-    return row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE && board[row][col] == EMPTY_SLOT;
+    return row >= 0 && row < rows && col >= 0 && col < cols && board[row][col] == EMPTY_SLOT;
 }
 
 bool TicTacToe::checkWin(char player) const {
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        if (board[i][0] == player && board[i][1] == player && board[i][2] == player) return true;
-        if (board[0][i] == player && board[1][i] == player && board[2][i] == player) return true;
+    // winLength marks from (i, j) rightwards, downwards and along both diagonals
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            if (board[i][j] != player) continue;
+            for (const auto& d : directions) {
+                int n = 1;
+                while (n < winLength) {
+                    int r = i + n * d[0], c = j + n * d[1];
+                    if (r >= rows || c < 0 || c >= cols || board[r][c] != player) break;
+                    ++n;
+                }
+                if (n == winLength) return true;
+            }
+        }
     }
-    if (board[0][0] == player && board[1][1] == player && board[2][2] == player) return true;
-    if (board[0][2] == player && board[1][1] == player && board[2][0] == player) return true;
     return false;
 }
 
 bool TicTacToe::isBoardFull() const {
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        for (int j = 0; j < BOARD_SIZE; ++j) {
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
             if (board[i][j] == EMPTY_SLOT) {
                 return false;
             }
@@ -162,8 +182,8 @@ void TicTacToe::getPlayerMove(int& row, int& col) {
         } else {
             // Provide specific feedback if the move is invalid
             cout << Color::BOLD_RED << "Invalid move. ";
-            if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) {
-                 cout << "Row and column must be between 0 and " << BOARD_SIZE - 1 << ".\n";
+            if (row < 0 || row >= rows || col < 0 || col >= cols) {
+                 cout << "Row must be between 0 and " << rows - 1 << ", column between 0 and " << cols - 1 << ".\n";
             } else {
                  cout << "Cell (" << row << ", " << col << ") is already taken.\n";
             }
@@ -174,15 +194,110 @@ void TicTacToe::getPlayerMove(int& row, int& col) {
 // --- End getPlayerMove ---
 
 
-// --- Minimax AI Implementation (logic unchanged) ---
+// --- Move table ---
+// Every 3x3 board has a base-3 code, cell (row * 3 + col) being digit
+// 3^(row * 3 + col): 0 empty, 1 HUMAN_PLAYER, 2 AI_PLAYER. Placing a mark
+// only ever raises the code, so walking the codes downwards evaluates every
+// board after all boards that follow it, and the whole minimax becomes one
+// pass over 3^9 boards, run once at static initialization (about a
+// millisecond; as a constexpr it exceeds the evaluation limits of most
+// compilers). The table holds exactly what findBestMove() computes with an
+// unlimited search, tie-breaks included.
+namespace {
+    constexpr int CELLS = 9;
+    constexpr int CODES = 19683; // 3^9
+    constexpr int LINES[8][3] = {
+        {0, 1, 2}, {3, 4, 5}, {6, 7, 8}, {0, 3, 6}, {1, 4, 7}, {2, 5, 8}, {0, 4, 8}, {2, 4, 6},
+    };
+
+    struct TableEntry {
+        int8_t cell;  // Best cell for AI_PLAYER to move, -1 on a full board
+        int8_t score; // Its minimax score
+    };
+
+    struct MoveTable {
+        TableEntry entries[CODES];
+    };
+
+    // minimax() one ply deeper: wins and losses move one step towards zero
+    constexpr int deeper(int score) { return score > 0 ? score - 1 : score < 0 ? score + 1 : 0; }
+
+    MoveTable buildMoveTable() {
+        MoveTable table{};
+        int8_t value[2][CODES] = {}; // minimax(0, isMaximizingPlayer) for [human, AI] to move
+        int power[CELLS] = {};
+        for (int i = 0, p = 1; i < CELLS; ++i, p *= 3) power[i] = p;
+
+        for (int code = CODES - 1; code >= 0; --code) {
+            int digit[CELLS] = {};
+            for (int i = 0, c = code; i < CELLS; ++i, c /= 3) digit[i] = c % 3;
+            bool humanWins = false, aiWins = false, full = true;
+            for (const auto& line : LINES) {
+                int d = digit[line[0]];
+                if (d != 0 && digit[line[1]] == d && digit[line[2]] == d) (d == 1 ? humanWins : aiWins) = true;
+            }
+            for (int d : digit) full = full && d != 0;
+
+            for (int aiToMove = 0; aiToMove < 2; ++aiToMove) {
+                int score = humanWins ? -10 : aiWins ? 10 : 0; // Same order as checkGameOver()
+                if (!humanWins && !aiWins && !full) {
+                    score = aiToMove ? -100 : 100;
+                    for (int i = 0; i < CELLS; ++i) {
+                        if (digit[i] != 0) continue;
+                        int child = deeper(value[1 - aiToMove][code + power[i] * (aiToMove ? 2 : 1)]);
+                        score = aiToMove ? (child > score ? child : score) : (child < score ? child : score);
+                    }
+                }
+                value[aiToMove][code] = static_cast<int8_t>(score);
+            }
+
+            // findBestMove(): the first cell whose reply position scores highest
+            TableEntry best{-1, 0};
+            for (int i = 0; i < CELLS; ++i) {
+                if (digit[i] != 0) continue;
+                int score = value[0][code + power[i] * 2];
+                if (best.cell == -1 || score > best.score) best = {static_cast<int8_t>(i), static_cast<int8_t>(score)};
+            }
+            table.entries[code] = best;
+        }
+        return table;
+    }
+
+    const MoveTable MOVE_TABLE = buildMoveTable();
+}
+
+TicTacToe::Move TicTacToe::tableMove() const {
+    int code = 0;
+    for (int i = BOARD_SIZE - 1; i >= 0; --i) {
+        for (int j = BOARD_SIZE - 1; j >= 0; --j) {
+            code = code * 3 + (board[i][j] == HUMAN_PLAYER ? 1 : board[i][j] == AI_PLAYER ? 2 : 0);
+        }
+    }
+    const TableEntry& entry = MOVE_TABLE.entries[code];
+    Move m;
+    if (entry.cell < 0) {
+        m.score = numeric_limits<int>::min(); // As findBestMove() without a legal move
+        return m;
+    }
+    m.row = entry.cell / BOARD_SIZE;
+    m.col = entry.cell % BOARD_SIZE;
+    m.score = entry.score;
+    return m;
+}
+// --- End move table ---
+
+
+// --- Minimax AI Implementation ---
 TicTacToe::Move TicTacToe::findBestMove() {
+    if (engine) return engineMove();
+    if (useMoveTable && searchDepth == 0) return tableMove(); // Perfect play: one lookup
     int bestScore = numeric_limits<int>::min();
     Move bestMove;
     bestMove.row = -1;
     bestMove.col = -1;
 
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        for (int j = 0; j < BOARD_SIZE; ++j) {
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
             if (board[i][j] == EMPTY_SLOT) {
                 board[i][j] = AI_PLAYER;
                 int moveScore = minimax(0, false);
@@ -200,18 +315,44 @@ TicTacToe::Move TicTacToe::findBestMove() {
     return bestMove;
 }
 
+// Boards beyond 3x3 are far too large for a plain minimax: MNKEngine
+// searches them with alpha-beta under THINK_TIME_MS
+TicTacToe::Move TicTacToe::engineMove() {
+    vector<int> owner(rows * cols, -1);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            if (board[i][j] == HUMAN_PLAYER) owner[i * cols + j] = 0;
+            else if (board[i][j] == AI_PLAYER) owner[i * cols + j] = 1;
+        }
+    }
+    MNKEngine::Result r = engine->search(owner, 1, THINK_TIME_MS, searchDepth);
+    nodes += r.nodes;
+
+    Move m;
+    if (r.cell < 0) {
+        m.score = numeric_limits<int>::min(); // As the minimax without a legal move
+        return m;
+    }
+    m.row = r.cell / cols;
+    m.col = r.cell % cols;
+    m.score = r.score;
+    return m;
+}
+
 int TicTacToe::minimax(int depth, bool isMaximizingPlayer) {
+    ++nodes;
     char winner;
     if (checkGameOver(winner)) {
         if (winner == AI_PLAYER) return 10 - depth;
         if (winner == HUMAN_PLAYER) return -10 + depth;
         return 0; // Draw
     }
+    if (searchDepth > 0 && depth + 1 >= searchDepth) return 0; // Horizon: treat as undecided
 
     if (isMaximizingPlayer) { // AI's turn (O)
         int bestScore = numeric_limits<int>::min();
-        for (int i = 0; i < BOARD_SIZE; ++i) {
-            for (int j = 0; j < BOARD_SIZE; ++j) {
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
                 if (board[i][j] == EMPTY_SLOT) {
                     board[i][j] = AI_PLAYER;
                     bestScore = max(bestScore, minimax(depth + 1, false));
@@ -222,8 +363,8 @@ int TicTacToe::minimax(int depth, bool isMaximizingPlayer) {
         return bestScore;
     } else { // Human's turn (X)
         int bestScore = numeric_limits<int>::max();
-        for (int i = 0; i < BOARD_SIZE; ++i) {
-            for (int j = 0; j < BOARD_SIZE; ++j) {
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
                 if (board[i][j] == EMPTY_SLOT) {
                     board[i][j] = HUMAN_PLAYER;
                     bestScore = min(bestScore, minimax(depth + 1, true));
@@ -234,6 +375,55 @@ int TicTacToe::minimax(int depth, bool isMaximizingPlayer) {
         return bestScore;
     }
 }
+
+// Analyzes an arbitrary position. The AI always plays AI_PLAYER, so positions
+// with HUMAN_PLAYER to move are searched with the marks exchanged.
+TicTacToe::Analysis TicTacToe::analyze(const Position& position, char player) {
+    Position saved = board;
+    board = position;
+    if (player == HUMAN_PLAYER) {
+        for (auto& row : board) {
+            for (char& cell : row) {
+                if (cell == HUMAN_PLAYER) cell = AI_PLAYER;
+                else if (cell == AI_PLAYER) cell = HUMAN_PLAYER;
+            }
+        }
+    }
+    nodes = 0;
+    Move m = findBestMove();
+    board = saved;
+
+    Analysis a;
+    a.row = m.row;
+    a.col = m.col;
+    a.score = m.row == -1 ? 0 : m.score;
+    a.nodes = nodes;
+    return a;
+}
+
+uint64_t TicTacToe::perft(const Position& position, char player, int depth) {
+    Position saved = board;
+    board = position;
+    uint64_t leaves = perftFrom(player, depth);
+    board = saved;
+    return leaves;
+}
+
+uint64_t TicTacToe::perftFrom(char player, int depth) {
+    if (depth == 0) return 1;
+    char opponent = player == HUMAN_PLAYER ? AI_PLAYER : HUMAN_PLAYER;
+    uint64_t leaves = 0;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            if (board[i][j] != EMPTY_SLOT) continue;
+            board[i][j] = player;
+            if (depth == 1) ++leaves;
+            else if (!checkWin(player)) leaves += perftFrom(opponent, depth - 1);
+            board[i][j] = EMPTY_SLOT;
+        }
+    }
+    return leaves;
+}
 // --- End AI Implementation ---
 
 
@@ -248,7 +438,7 @@ void TicTacToe::play() {
     while (!gameOver) {
         clearScreen(); // Clear screen at the start of each turn
         // Display colored title
-        cout << Color::BOLD_YELLOW << "=== Tic-Tac-Toe ===\n" << Color::RESET;
+        cout << Color::BOLD_YELLOW << "=== " << getName() << " ===\n" << Color::RESET;
         displayBoard(); // Display the current board state
 
         string status; // To display whose turn it is
@@ -265,8 +455,8 @@ void TicTacToe::play() {
             cout << status << "\n";
             cout.flush(); // Ensure message is shown before delay
 
-            // Add a small delay to simulate AI thinking
-            this_thread::sleep_for(chrono::milliseconds(500)); // 0.5 second delay
+            // Add a small delay to simulate AI thinking (the engine really thinks that long)
+            if (!engine) this_thread::sleep_for(chrono::milliseconds(500)); // 0.5 second delay
 
             Move aiMove = findBestMove(); // Calculate the AI's best move using Minimax
 
@@ -296,7 +486,7 @@ void TicTacToe::play() {
     // --- Game Over Section ---
     clearScreen(); // Clear screen for the final result display
     // Display colored game over title
-    cout << Color::BOLD_YELLOW << "=== Tic-Tac-Toe: Game Over ===\n" << Color::RESET;
+    cout << Color::BOLD_YELLOW << "=== " << getName() << ": Game Over ===\n" << Color::RESET;
     displayBoard(); // Show the final board state
 
     // Display the outcome message with color
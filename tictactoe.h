@@ -2,27 +2,67 @@
 #define TICTACTOE_H
 
 #include "game.h"
+#include "mnkengine.h"
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <memory>
 
 class TicTacToe : public Game {
 public:
-    TicTacToe();
+    // rows x cols board, winLength marks in a row win (3, 3, 3 is the classic game)
+    TicTacToe(int rows = BOARD_SIZE, int cols = BOARD_SIZE, int winLength = BOARD_SIZE);
     void play() override; // Implement the pure virtual function
-    std::string getName() const override { return "Tic-Tac-Toe"; }
+    std::string getName() const override;
     virtual ~TicTacToe() = default; // Use default destructor
 
-private:
     // Constants
     static const char HUMAN_PLAYER = 'X';
     static const char AI_PLAYER = 'O';
     static const char EMPTY_SLOT = ' ';
-    static const int BOARD_SIZE = 3;
+    static const int BOARD_SIZE = 3; // Classic board side and line length
+    static const int THINK_TIME_MS = 500; // Search time per move on larger boards
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getWinLength() const { return winLength; }
+
+    // --- Engine interface for non-interactive use ---
+    // A position is getRows() rows of getCols() cells, each HUMAN_PLAYER,
+    // AI_PLAYER or EMPTY_SLOT
+    using Position = std::vector<std::vector<char>>;
+    struct Analysis {
+        int row = -1, col = -1; // -1 if there is no empty cell
+        int score = 0;          // From the side to move's point of view
+        uint64_t nodes = 0;     // Positions visited by the search
+    };
 
+    // Look this many plies ahead. On the classic board unfinished positions
+    // score as draws and 0 searches to the end of the game (perfect play);
+    // larger boards are searched by MNKEngine for THINK_TIME_MS, with this
+    // as an extra depth limit (0 = time only).
+    void setSearchDepth(int plies) { searchDepth = plies; }
+    // Perfect play comes from a move table built once at startup; turning
+    // it off runs the full minimax instead (for benchmarking the search)
+    void setUseMoveTable(bool enabled) { useMoveTable = enabled; }
+    // Best move for `player` (HUMAN_PLAYER or AI_PLAYER) in `position`
+    Analysis analyze(const Position& position, char player);
+
+    // Leaf count of the move tree `depth` plies below `position` with
+    // `player` to move; a move that ends the game ends its branch
+    uint64_t perft(const Position& position, char player, int depth);
+
+private:
     // Board representation
+    int rows, cols, winLength;
     std::vector<std::vector<char>> board;
+    std::unique_ptr<MNKEngine> engine; // Searches every board but the classic one
+    int searchDepth = 0; // Plies searched by the AI, 0 = unlimited
+    uint64_t nodes = 0;  // Counted by minimax for analyze()
+    bool useMoveTable = true;
 
     // Internal game logic methods
+    bool isClassic() const { return rows == BOARD_SIZE && cols == BOARD_SIZE && winLength == BOARD_SIZE; }
     void initializeBoard();
     void displayBoard() const;
     bool isValidMove(int row, int col) const;
@@ -38,7 +78,10 @@ private:
     };
 
     Move findBestMove();
+    Move tableMove() const;  // findBestMove() for perfect play, by table lookup
+    Move engineMove();       // findBestMove() on boards other than the classic one
     int minimax(int depth, bool isMaximizingPlayer); // Pass board implicitly as member
+    uint64_t perftFrom(char player, int depth);
 };
 
 #endif // TICTACTOE_H
\ No newline at end of file
@@ -0,0 +1,362 @@
+#include "tournament.h"
+#include "connectfour.h"
+#include "tictactoe.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+// --- Match statistics ---
+double Tournament::Summary::score() const {
+    return games() ? (wins + 0.5 * draws) / games() : 0.5;
+}
+
+namespace {
+    // Elo difference that predicts a score fraction s
+    double eloFromScore(double s) {
+        if (s <= 0.0) return -numeric_limits<double>::infinity();
+        if (s >= 1.0) return numeric_limits<double>::infinity();
+        return 400.0 * log10(s / (1.0 - s));
+    }
+}
+
+double Tournament::Summary::eloDifference() const {
+    return eloFromScore(score());
+}
+
+// Normal approximation: the per-game score variance gives the standard
+// error of the mean score, whose 95% interval is mapped to Elo
+double Tournament::Summary::eloMargin() const {
+    int n = games();
+    if (n == 0) return numeric_limits<double>::infinity();
+    double s = score();
+    double variance = (wins * (1.0 - s) * (1.0 - s) + draws * (0.5 - s) * (0.5 - s) + losses * s * s) / n;
+    double error = 1.96 * sqrt(variance / n);
+    return (eloFromScore(s + error) - eloFromScore(s - error)) / 2.0;
+}
+// --- End match statistics ---
+
+// --- Parallel runner ---
+int Tournament::workerCount(int threads, int games) {
+    if (threads <= 0) threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    return max(1, min(threads, games));
+}
+
+Tournament::Summary Tournament::run(int games, int threads, const function<GameRecord(int, int)>& playGame) {
+    Summary summary;
+    mutex summaryMutex;
+    atomic<int> nextGame{0};
+    const int progressStep = max(1, games / 20);
+    auto start = chrono::steady_clock::now();
+
+    auto work = [&](int worker) {
+        for (int game; (game = nextGame++) < games;) {
+            GameRecord r = playGame(worker, game);
+            lock_guard<mutex> lock(summaryMutex);
+            if (r.result > 0) ++summary.wins;
+            else if (r.result < 0) ++summary.losses;
+            else ++summary.draws;
+            summary.secondsA += r.secondsA;
+            summary.secondsB += r.secondsB;
+            summary.movesA += r.movesA;
+            summary.movesB += r.movesB;
+            if (summary.games() % progressStep == 0) {
+                cerr << "  " << summary.games() << "/" << games << " games: +" << summary.wins
+                     << " =" << summary.draws << " -" << summary.losses << "\n";
+            }
+        }
+    };
+
+    int workers = workerCount(threads, games);
+    vector<thread> pool;
+    for (int i = 1; i < workers; ++i) pool.emplace_back(work, i);
+    work(0);
+    for (thread& t : pool) t.join();
+
+    summary.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return summary;
+}
+// --- End parallel runner ---
+
+namespace {
+
+// --- Engine specifications ---
+// "name,key=value,key=value", e.g. "mcts,ms=50" or "minimax,depth=2"
+struct EngineSpec {
+    string text;
+    string name;
+    map<string, int> options;
+
+    int get(const string& key, int fallback) const {
+        auto it = options.find(key);
+        return it == options.end() ? fallback : it->second;
+    }
+};
+
+bool parseSpec(const string& text, const vector<string>& names, const vector<string>& keys,
+               EngineSpec& spec, string& error) {
+    spec = EngineSpec();
+    spec.text = text;
+    stringstream in(text);
+    string item;
+    getline(in, spec.name, ',');
+    if (find(names.begin(), names.end(), spec.name) == names.end()) {
+        error = "unknown engine '" + spec.name + "' in '" + text + "'";
+        return false;
+    }
+    while (getline(in, item, ',')) {
+        size_t eq = item.find('=');
+        string key = item.substr(0, eq);
+        if (eq == string::npos || find(keys.begin(), keys.end(), key) == keys.end()) {
+            error = "bad option '" + item + "' in '" + text + "'";
+            return false;
+        }
+        spec.options[key] = atoi(item.c_str() + eq + 1);
+    }
+    return true;
+}
+// --- End engine specifications ---
+
+// --- Connect Four ---
+// Options: ms (time per move, default 50), depth (alpha-beta depth limit,
+// 0 = none), threads (per engine, default 1), tt (table MB, default 4),
+// arena (MCTS MB, default 16), solver (empty cells, default 0 = off),
+// book (1 = use connectfour.book, default 0)
+unique_ptr<ConnectFour> makeConnectFour(const EngineSpec& spec) {
+    auto engine = make_unique<ConnectFour>(spec.get("ms", 50), spec.get("tt", 4), spec.get("threads", 1));
+    if (spec.name == "mcts") engine->setEngine(ConnectFour::Engine::MCTS, spec.get("arena", 16));
+    engine->setMaxDepth(spec.get("depth", 0));
+    engine->setPerfectPlayThreshold(spec.get("solver", 0));
+    engine->setUseOpeningBook(spec.get("book", 0) != 0);
+    engine->setPondering(false);
+    return engine;
+}
+
+// Random opening in which nobody wins or can win on the next move; the
+// same opening is returned for both games of a pair
+vector<int> connectFourOpening(int plies, unsigned seed, int pair) {
+    mt19937 rng(seed * 1000003u + static_cast<unsigned>(pair));
+    for (;;) {
+        ConnectFourBoard board;
+        int side = ConnectFourBoard::HUMAN_SIDE;
+        vector<int> moves;
+        while (static_cast<int>(moves.size()) < plies) {
+            int candidates[ConnectFourBoard::COLS];
+            int n = 0;
+            for (int c = 0; c < ConnectFourBoard::COLS; ++c) {
+                if (!board.canPlay(c) || board.isWinningMove(c, side)) continue;
+                board.play(c, side);
+                bool givesWin = false;
+                for (int d = 0; d < ConnectFourBoard::COLS; ++d) {
+                    if (board.canPlay(d) && board.isWinningMove(d, 1 - side)) givesWin = true;
+                }
+                board.undo(c);
+                if (!givesWin) candidates[n++] = c;
+            }
+            if (n == 0) break;
+            int col = candidates[rng() % n];
+            board.play(col, side);
+            moves.push_back(col);
+            side = 1 - side;
+        }
+        if (static_cast<int>(moves.size()) == plies) return moves;
+    }
+}
+
+Tournament::GameRecord playConnectFour(ConnectFour& a, ConnectFour& b, int msA, int msB,
+                                       const vector<int>& opening, bool aPlaysFirstSide) {
+    ConnectFourBoard board;
+    int side = ConnectFourBoard::HUMAN_SIDE; // HUMAN_SIDE makes the first move
+    for (int col : opening) {
+        board.play(col, side);
+        side = 1 - side;
+    }
+    const int aSide = aPlaysFirstSide ? ConnectFourBoard::HUMAN_SIDE : ConnectFourBoard::AI_SIDE;
+    a.newGame();
+    b.newGame();
+
+    Tournament::GameRecord record;
+    while (!board.isFull()) {
+        bool aToMove = side == aSide;
+        auto start = chrono::steady_clock::now();
+        ConnectFour::Analysis m = (aToMove ? a : b).analyze(board, side, aToMove ? msA : msB);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        (aToMove ? record.secondsA : record.secondsB) += seconds;
+        ++(aToMove ? record.movesA : record.movesB);
+
+        if (m.col < 0 || !board.canPlay(m.col)) { // Illegal move forfeits
+            record.result = aToMove ? -1 : 1;
+            return record;
+        }
+        board.play(m.col, side);
+        if (board.hasWon(side)) {
+            record.result = aToMove ? 1 : -1;
+            return record;
+        }
+        side = 1 - side;
+    }
+    return record; // Draw
+}
+// --- End Connect Four ---
+
+// --- Tic-Tac-Toe ---
+// Options: depth (plies searched, default 0 = perfect play)
+using TicTacToePosition = TicTacToe::Position;
+
+bool ticTacToeWon(const TicTacToePosition& p, char player) {
+    for (int i = 0; i < TicTacToe::BOARD_SIZE; ++i) {
+        if (p[i][0] == player && p[i][1] == player && p[i][2] == player) return true;
+        if (p[0][i] == player && p[1][i] == player && p[2][i] == player) return true;
+    }
+    return (p[0][0] == player && p[1][1] == player && p[2][2] == player) ||
+           (p[0][2] == player && p[1][1] == player && p[2][0] == player);
+}
+
+// Random opening cells (row-major indices); four plies cannot win yet
+vector<int> ticTacToeOpening(int plies, unsigned seed, int pair) {
+    mt19937 rng(seed * 1000003u + static_cast<unsigned>(pair));
+    vector<int> cells(TicTacToe::BOARD_SIZE * TicTacToe::BOARD_SIZE);
+    for (size_t i = 0; i < cells.size(); ++i) cells[i] = static_cast<int>(i);
+    shuffle(cells.begin(), cells.end(), rng);
+    cells.resize(min(plies, 4));
+    return cells;
+}
+
+Tournament::GameRecord playTicTacToe(TicTacToe& a, TicTacToe& b, const vector<int>& opening, bool aPlaysFirstSide) {
+    const int n = TicTacToe::BOARD_SIZE;
+    TicTacToePosition board(n, vector<char>(n, TicTacToe::EMPTY_SLOT));
+    char player = TicTacToe::HUMAN_PLAYER; // X moves first
+    auto other = [](char p) { return p == TicTacToe::HUMAN_PLAYER ? TicTacToe::AI_PLAYER : TicTacToe::HUMAN_PLAYER; };
+    for (int cell : opening) {
+        board[cell / n][cell % n] = player;
+        player = other(player);
+    }
+    const char aPlayer = aPlaysFirstSide ? TicTacToe::HUMAN_PLAYER : TicTacToe::AI_PLAYER;
+
+    Tournament::GameRecord record;
+    for (int ply = static_cast<int>(opening.size()); ply < n * n; ++ply) {
+        bool aToMove = player == aPlayer;
+        auto start = chrono::steady_clock::now();
+        TicTacToe::Analysis m = (aToMove ? a : b).analyze(board, player);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        (aToMove ? record.secondsA : record.secondsB) += seconds;
+        ++(aToMove ? record.movesA : record.movesB);
+
+        if (m.row < 0 || board[m.row][m.col] != TicTacToe::EMPTY_SLOT) {
+            record.result = aToMove ? -1 : 1;
+            return record;
+        }
+        board[m.row][m.col] = player;
+        if (ticTacToeWon(board, player)) {
+            record.result = aToMove ? 1 : -1;
+            return record;
+        }
+        player = other(player);
+    }
+    return record; // Draw
+}
+// --- End Tic-Tac-Toe ---
+
+void printUsage() {
+    cerr << "Usage: gamehub tournament <game> <engineA> <engineB> [games] [threads] [opening] [seed]\n"
+         << "  game      connectfour or tictactoe\n"
+         << "  engine    name[,key=value...]\n"
+         << "            connectfour: alphabeta or mcts; keys ms, depth, threads, tt, arena, solver, book\n"
+         << "            tictactoe:   minimax; key depth (0 = perfect play)\n"
+         << "  games     number of games (default 100), played in pairs with colors swapped\n"
+         << "  threads   games played at once (default 0 = one per core)\n"
+         << "  opening   random plies before the engines take over (default 4, tictactoe 1)\n"
+         << "  seed      opening seed (default 1)\n"
+         << "Example: gamehub tournament connectfour alphabeta,ms=50 mcts,ms=50 1000\n";
+}
+
+void printSummary(const string& game, const EngineSpec& a, const EngineSpec& b, const Tournament::Summary& s,
+                  int workers, int openingPlies, unsigned seed) {
+    auto latencyMs = [](double seconds, long long moves) { return moves ? 1000.0 * seconds / moves : 0.0; };
+    cout << "Tournament " << game << ": A = " << a.text << "  vs  B = " << b.text << "\n"
+         << "Games " << s.games() << " on " << workers << " threads, " << openingPlies
+         << " random opening plies, seed " << seed << "\n"
+         << "A: " << s.wins << " wins, " << s.draws << " draws, " << s.losses << " losses (score "
+         << fixed << setprecision(1) << 100.0 * s.score() << "%)\n"
+         << "Elo difference (A - B): " << showpos << s.eloDifference() << noshowpos
+         << " +/- " << s.eloMargin() << " (95% confidence)\n"
+         << "Throughput: " << setprecision(2) << s.games() / s.seconds << " games/s in "
+         << setprecision(1) << s.seconds << " s\n"
+         << "Average move latency: A " << setprecision(2) << latencyMs(s.secondsA, s.movesA) << " ms, B "
+         << latencyMs(s.secondsB, s.movesB) << " ms\n";
+}
+
+}
+
+int runTournament(const vector<string>& args) {
+    if (args.size() < 3) {
+        printUsage();
+        return 1;
+    }
+    const string& game = args[0];
+    bool connectFour = game == "connectfour";
+    if (!connectFour && game != "tictactoe") {
+        cerr << "Error: unknown game '" << game << "'.\n";
+        printUsage();
+        return 1;
+    }
+    int games = args.size() > 3 ? atoi(args[3].c_str()) : 100;
+    int threads = args.size() > 4 ? atoi(args[4].c_str()) : 0;
+    int openingPlies = args.size() > 5 ? atoi(args[5].c_str()) : (connectFour ? 4 : 1);
+    unsigned seed = args.size() > 6 ? static_cast<unsigned>(atoi(args[6].c_str())) : 1;
+    if (games <= 0 || openingPlies < 0 || openingPlies > (connectFour ? 20 : 4)) {
+        cerr << "Error: invalid tournament arguments.\n";
+        return 1;
+    }
+
+    vector<string> names = connectFour ? vector<string>{"alphabeta", "mcts"} : vector<string>{"minimax"};
+    vector<string> keys = connectFour ? vector<string>{"ms", "depth", "threads", "tt", "arena", "solver", "book"}
+                                      : vector<string>{"depth"};
+    EngineSpec specA, specB;
+    string error;
+    if (!parseSpec(args[1], names, keys, specA, error) || !parseSpec(args[2], names, keys, specB, error)) {
+        cerr << "Error: " << error << "\n";
+        printUsage();
+        return 1;
+    }
+
+    int workers = Tournament::workerCount(threads, games);
+    cerr << "Playing " << games << " " << game << " games on " << workers << " threads...\n";
+    Tournament::Summary summary;
+    if (connectFour) {
+        vector<unique_ptr<ConnectFour>> enginesA, enginesB;
+        for (int i = 0; i < workers; ++i) {
+            enginesA.push_back(makeConnectFour(specA));
+            enginesB.push_back(makeConnectFour(specB));
+        }
+        int msA = specA.get("ms", 50), msB = specB.get("ms", 50);
+        summary = Tournament::run(games, workers, [&](int worker, int g) {
+            vector<int> opening = connectFourOpening(openingPlies, seed, g / 2);
+            return playConnectFour(*enginesA[worker], *enginesB[worker], msA, msB, opening, g % 2 == 0);
+        });
+    } else {
+        vector<TicTacToe> enginesA(workers), enginesB(workers);
+        for (int i = 0; i < workers; ++i) {
+            enginesA[i].setSearchDepth(specA.get("depth", 0));
+            enginesB[i].setSearchDepth(specB.get("depth", 0));
+        }
+        summary = Tournament::run(games, workers, [&](int worker, int g) {
+            vector<int> opening = ticTacToeOpening(openingPlies, seed, g / 2);
+            return playTicTacToe(enginesA[worker], enginesB[worker], opening, g % 2 == 0);
+        });
+    }
+    printSummary(game, specA, specB, summary, workers, openingPlies, seed);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Headless engine-vs-engine matches, played in parallel.
+//
+// Games come in pairs that start from the same random opening with the
+// engines' colors swapped, so neither side profits from a lucky opening or
+// from moving first. Every worker thread owns its own engine instances and
+// takes the next game number from a shared counter.
+class Tournament {
+public:
+    // Outcome of one game from engine A's point of view
+    struct GameRecord {
+        int result = 0;        // +1 A won, 0 draw, -1 B won
+        double secondsA = 0.0; // Time spent choosing moves
+        double secondsB = 0.0;
+        int movesA = 0;
+        int movesB = 0;
+    };
+
+    struct Summary {
+        int wins = 0, draws = 0, losses = 0; // For engine A
+        double seconds = 0.0;                // Wall time of the whole match
+        double secondsA = 0.0, secondsB = 0.0;
+        long long movesA = 0, movesB = 0;
+
+        int games() const { return wins + draws + losses; }
+        double score() const;         // A's score fraction, draws count half
+        double eloDifference() const; // Elo of A minus Elo of B (infinite on a clean sweep)
+        double eloMargin() const;     // Half-width of the 95% confidence interval
+    };
+
+    // Worker threads used for `threads` (0 = one per core), at most one per game
+    static int workerCount(int threads, int games);
+
+    // Plays games 0 .. games-1 on workerCount(threads, games) threads.
+    // playGame(worker, game) is called on worker thread `worker`.
+    static Summary run(int games, int threads, const std::function<GameRecord(int worker, int game)>& playGame);
+};
+
+// `gamehub tournament <game> <engineA> <engineB> [games] [threads] [opening] [seed]`;
+// returns the process exit code
+int runTournament(const std::vector<std::string>& args);
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,74 @@
+#include "transpositiontable.h"
+#include <algorithm>
+
+using namespace std;
+
+static_assert(sizeof(atomic<uint64_t>) == 8, "TT slots assume lock-free 64-bit atomics");
+
+// Data word layout: score (32 bits) | depth (8) | bound (8) | move + 1 (8)
+uint64_t TranspositionTable::pack(int score, int depth, Bound bound, int bestMove) {
+    return (uint64_t(uint32_t(score)) << 32)
+         | (uint64_t(uint8_t(depth)) << 16)
+         | (uint64_t(bound) << 8)
+         | uint64_t(uint8_t(bestMove + 1));
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) {
+    Entry e;
+    e.score = int32_t(uint32_t(data >> 32));
+    e.depth = int8_t(uint8_t(data >> 16));
+    e.bound = Bound(uint8_t(data >> 8));
+    e.bestMove = int(uint8_t(data)) - 1;
+    return e;
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t bytes = max<size_t>(megabytes, 1) * 1024 * 1024;
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= bytes) count *= 2;
+    buckets.reset(new Bucket[count]);
+    bucketCount = count;
+    indexMask = count - 1;
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        for (Slot& s : buckets[i].slots) {
+            s.check.store(0, memory_order_relaxed);
+            s.data.store(0, memory_order_relaxed);
+        }
+    }
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& out) const {
+    const Bucket& bucket = buckets[key & indexMask];
+    for (const Slot& s : bucket.slots) {
+        uint64_t data = s.data.load(memory_order_relaxed);
+        uint64_t check = s.check.load(memory_order_relaxed);
+        if (data != 0 && (check ^ data) == key) {
+            out = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, int score, Bound bound, int bestMove) {
+    Bucket& bucket = buckets[key & indexMask];
+    // Replace the same position if present, otherwise an empty or the shallowest slot
+    Slot* target = &bucket.slots[0];
+    int targetDepth = 1 << 30;
+    for (Slot& s : bucket.slots) {
+        uint64_t data = s.data.load(memory_order_relaxed);
+        if (data == 0 || (s.check.load(memory_order_relaxed) ^ data) == key) { target = &s; break; }
+        int d = unpack(data).depth;
+        if (d < targetDepth) { target = &s; targetDepth = d; }
+    }
+    uint64_t data = pack(score, depth, bound, bestMove);
+    target->check.store(key ^ data, memory_order_relaxed);
+    target->data.store(data, memory_order_relaxed);
+}
@@ -0,0 +1,66 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// Fixed-size hash table of search results, keyed by a 64-bit position hash.
+// Entries are grouped into 64-byte buckets so one probe touches one cache line.
+//
+// The table is shared by all search threads without locks: each slot stores
+// (key ^ data) next to data, so a slot torn by two concurrent writers fails
+// the key check on probe instead of returning mixed-up results.
+class TranspositionTable {
+public:
+    // How the stored score relates to the true value of the position
+    enum Bound : uint8_t {
+        BOUND_NONE = 0,
+        BOUND_EXACT = 1, // score == value
+        BOUND_LOWER = 2, // score <= value (search failed high)
+        BOUND_UPPER = 3  // score >= value (search failed low)
+    };
+
+    // Decoded entry returned by probe()
+    struct Entry {
+        int score = 0;
+        int depth = 0;        // Remaining search depth the score is valid for
+        Bound bound = BOUND_NONE;
+        int bestMove = -1;    // Column, -1 if unknown
+    };
+
+    static const int ENTRIES_PER_BUCKET = 4;
+
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    void resize(size_t megabytes); // Rounds down to a power-of-two bucket count
+    void clear();                  // Empties the table (not thread-safe)
+
+    // Returns true and fills `out` if the key is stored. Safe to call from
+    // several threads while others store.
+    bool probe(uint64_t key, Entry& out) const;
+    void store(uint64_t key, int depth, int score, Bound bound, int bestMove);
+
+    size_t sizeBytes() const { return bucketCount * sizeof(Bucket); }
+    size_t capacity() const { return bucketCount * ENTRIES_PER_BUCKET; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check{0}; // key ^ data
+        std::atomic<uint64_t> data{0};  // Packed score/depth/bound/move
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[ENTRIES_PER_BUCKET];
+    };
+
+    static uint64_t pack(int score, int depth, Bound bound, int bestMove);
+    static Entry unpack(uint64_t data);
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t bucketCount = 0;
+    uint64_t indexMask = 0;
+};
+
+#endif // TRANSPOSITIONTABLE_H
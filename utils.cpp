@@ -67,4 +67,26 @@ int getIntInput(const std::string& prompt, int minVal, int maxVal) {
             return value;
         }
     }
-}
\ No newline at end of file
+}
+uint64_t getUInt64Input(const std::string& prompt, uint64_t minVal, uint64_t maxVal) {
+    uint64_t value;
+    while (true) {
+        std::cout << Color::CYAN << prompt << Color::RESET;
+        std::cout.flush();
+
+        // Extraction would wrap a negative number around instead of failing
+        bool negative = (std::cin >> std::ws).peek() == '-';
+        if (negative || !(std::cin >> value)) {
+            std::cout << Color::BOLD_RED << "Invalid input. Please enter a non-negative number.\n" << Color::RESET;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        } else if (value < minVal || value > maxVal) {
+            std::cout << Color::BOLD_RED << "Input out of range. Please enter a value between "
+                      << minVal << " and " << maxVal << ".\n" << Color::RESET;
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        } else {
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            return value;
+        }
+    }
+}
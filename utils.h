@@ -1,6 +1,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -32,4 +33,7 @@ void pressEnterToContinue();
 // Function to get validated integer input within a range
 int getIntInput(const std::string& prompt, int minVal = -2147483648, int maxVal = 2147483647);
 
+// Same for unsigned 64-bit values (e.g. pile sizes beyond the int range)
+uint64_t getUInt64Input(const std::string& prompt, uint64_t minVal, uint64_t maxVal);
+
 #endif // UTILS_H
\ No newline at end of file